@@ -0,0 +1 @@
+#include "gdwg_all_pairs.h"
@@ -0,0 +1,332 @@
+#ifndef GDWG_ALL_PAIRS_H
+#define GDWG_ALL_PAIRS_H
+
+#include "gdwg_graph.h"
+#include "gdwg_parallel.h"
+#include "gdwg_shortest_paths.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace gdwg {
+	// Shortest distances between every pair of a graph's nodes, as one row-major n by n array. Rows
+	// and columns are the graph's dense node ids, and unreachable pairs hold infinite_distance.
+	// The matrix keeps its own copy of the node values, so it outlives the graph it came from.
+	template<typename N, typename E>
+	class distance_matrix {
+	 public:
+		using node_id = std::uint32_t;
+
+		// Constructors and Destructors
+		distance_matrix() = default;
+
+		// A matrix over g's nodes with every node at distance zero from itself and every other pair
+		// unreachable.
+		explicit distance_matrix(graph<N, E> const& g)
+		: nodes_(g.node_count())
+		, sorted_(g.node_count())
+		, distances_(g.node_count() * g.node_count(), infinite_distance<E>) {
+			for (auto v = node_id{0}; v < nodes_.size(); ++v) {
+				nodes_[v] = g.node(v);
+				sorted_[v] = v;
+				distances_[v * nodes_.size() + v] = E{0};
+			}
+			std::sort(sorted_.begin(), sorted_.end(), [this](node_id a, node_id b) { return nodes_[a] < nodes_[b]; });
+		}
+
+		// Accessors
+		[[nodiscard]] auto node_count() const noexcept -> std::size_t {
+			return nodes_.size();
+		}
+
+		[[nodiscard]] auto id_of(N const& value) const -> std::optional<node_id> {
+			auto it = std::lower_bound(sorted_.begin(), sorted_.end(), value, [this](node_id id, N const& key) {
+				return nodes_[id] < key;
+			});
+			if (it == sorted_.end() or nodes_[*it] != value) {
+				return std::nullopt;
+			}
+			return *it;
+		}
+
+		[[nodiscard]] auto node(node_id id) const -> N const& {
+			return nodes_[id];
+		}
+
+		// The distance from src to dst. Throws std::runtime_error if either is not a node.
+		[[nodiscard]] auto at(N const& src, N const& dst) const -> E {
+			auto const from = id_of(src);
+			auto const to = id_of(dst);
+			if (!from or !to) {
+				throw std::runtime_error("Cannot call gdwg::distance_matrix<N, E>::at if src or dst node don't exist "
+				                         "in the matrix");
+			}
+			return distance(*from, *to);
+		}
+
+		// Dense Access
+		[[nodiscard]] auto distance(node_id from, node_id to) const -> E {
+			return distances_[from * nodes_.size() + to];
+		}
+
+		[[nodiscard]] auto reachable(node_id from, node_id to) const -> bool {
+			return distance(from, to) != infinite_distance<E>;
+		}
+
+		[[nodiscard]] auto row(node_id from) const -> std::span<E const> {
+			return std::span<E const>(distances_).subspan(from * nodes_.size(), nodes_.size());
+		}
+
+		[[nodiscard]] auto row(node_id from) -> std::span<E> {
+			return std::span<E>(distances_).subspan(from * nodes_.size(), nodes_.size());
+		}
+
+		[[nodiscard]] auto data() noexcept -> E* {
+			return distances_.data();
+		}
+
+	 private:
+		std::vector<N> nodes_;
+		// Node ids in ascending order of their values, for id_of.
+		std::vector<node_id> sorted_;
+		std::vector<E> distances_;
+	};
+
+	template<typename E>
+	struct all_pairs_options {
+		// The cost of traversing an unweighted edge.
+		E unweighted_cost = E{1};
+		// The side of the square tiles Floyd-Warshall works through. Three tiles should fit in
+		// cache together.
+		std::size_t block = 64;
+		// Threads used when no worker_pool is supplied. Zero uses every hardware thread.
+		std::size_t threads = 0;
+	};
+
+	namespace detail {
+		// Relaxes every d[i][j] with i in [i0, i1) and j in [j0, j1) through every k in [k0, k1).
+		// The innermost loop runs along a row with no branches, so it auto-vectorizes. A negative
+		// cycle drives distances down without bound, so signed integral sums saturate at lowest()
+		// rather than overflow before the cycle is reported.
+		template<typename E>
+		auto relax_tile(E* d,
+		                std::size_t n,
+		                std::size_t i0,
+		                std::size_t i1,
+		                std::size_t j0,
+		                std::size_t j1,
+		                std::size_t k0,
+		                std::size_t k1) -> void {
+			constexpr auto infinite = infinite_distance<E>;
+			for (auto k = k0; k < k1; ++k) {
+				auto const* const through_k = d + k * n;
+				for (auto i = i0; i < i1; ++i) {
+					auto* const from_i = d + i * n;
+					auto const to_k = from_i[k];
+					if (to_k == infinite) {
+						continue;
+					}
+					// Any through_k[j] below floor would take the sum below lowest().
+					constexpr auto saturate = std::is_integral_v<E> and std::is_signed_v<E>;
+					auto const floor = std::numeric_limits<E>::lowest() - std::min(to_k, E{0});
+					for (auto j = j0; j < j1; ++j) {
+						auto const through = through_k[j];
+						// Floating-point infinity absorbs the addition, but an integer sentinel would overflow,
+						// so it is swapped for zero before adding and the sum discarded afterwards.
+						auto const unreachable = !std::numeric_limits<E>::has_infinity and through == infinite;
+						auto const addend = unreachable ? E{0} : through;
+						auto const sum =
+						    saturate and addend < floor ? std::numeric_limits<E>::lowest() : to_k + addend;
+						auto const candidate = unreachable ? infinite : sum;
+						from_i[j] = candidate < from_i[j] ? candidate : from_i[j];
+					}
+				}
+			}
+		}
+
+		template<typename N, typename E>
+		auto check_negative_cycle(distance_matrix<N, E> const& matrix, char const* function) -> void {
+			if constexpr (std::is_signed_v<E>) {
+				for (auto v = std::uint32_t{0}; v < matrix.node_count(); ++v) {
+					if (matrix.distance(v, v) < E{0}) {
+						throw std::runtime_error(std::string("Cannot call ") + function
+						                         + " on a graph with a negative cycle");
+					}
+				}
+			}
+		}
+	} // namespace detail
+
+	// All-pairs shortest paths by Floyd-Warshall in O(V^3) time and O(V^2) space, for small to
+	// medium graphs that are dense. The matrix is processed in square tiles of options.block:
+	// each round finishes the diagonal tile, then the tiles sharing its row or column, and then
+	// every other tile, which only reads those; the tiles within each step run on pool's workers.
+	// Parallel edges count at their cheapest. Negative weights are allowed, but throws
+	// std::runtime_error if g has a negative cycle.
+	template<typename N, typename E>
+	requires std::is_arithmetic_v<E>
+	auto floyd_warshall(graph<N, E> const& g, worker_pool& pool, all_pairs_options<E> const& options = {})
+	    -> distance_matrix<N, E> {
+		auto matrix = distance_matrix<N, E>(g);
+		auto const n = matrix.node_count();
+		for (auto u = std::uint32_t{0}; u < n; ++u) {
+			auto row = matrix.row(u);
+			for (auto const& record : g.out_edges(u)) {
+				row[record.dst] = std::min(row[record.dst], detail::edge_cost(record, options.unweighted_cost));
+			}
+		}
+
+		auto* const d = matrix.data();
+		auto const block = std::max(options.block, std::size_t{1});
+		auto const blocks = (n + block - 1) / block;
+		auto const bounds = [&](std::size_t b) { return std::pair{b * block, std::min(n, (b + 1) * block)}; };
+		for (auto kb = std::size_t{0}; kb < blocks; ++kb) {
+			auto const [k0, k1] = bounds(kb);
+			detail::relax_tile(d, n, k0, k1, k0, k1, k0, k1);
+			// Tiles [0, blocks) share the diagonal tile's row and [blocks, 2 * blocks) its column.
+			pool.for_each(
+			    2 * blocks,
+			    [&](std::size_t, std::size_t t) {
+				    auto const other = t % blocks;
+				    if (other == kb) {
+					    return;
+				    }
+				    auto const [o0, o1] = bounds(other);
+				    if (t < blocks) {
+					    detail::relax_tile(d, n, k0, k1, o0, o1, k0, k1);
+				    }
+				    else {
+					    detail::relax_tile(d, n, o0, o1, k0, k1, k0, k1);
+				    }
+			    },
+			    1);
+			pool.for_each(
+			    blocks * blocks,
+			    [&](std::size_t, std::size_t t) {
+				    auto const ib = t / blocks;
+				    auto const jb = t % blocks;
+				    if (ib == kb or jb == kb) {
+					    return;
+				    }
+				    auto const [i0, i1] = bounds(ib);
+				    auto const [j0, j1] = bounds(jb);
+				    detail::relax_tile(d, n, i0, i1, j0, j1, k0, k1);
+			    },
+			    1);
+		}
+		detail::check_negative_cycle(matrix, "gdwg::floyd_warshall");
+		return matrix;
+	}
+
+	template<typename N, typename E>
+	requires std::is_arithmetic_v<E>
+	auto floyd_warshall(graph<N, E> const& g, all_pairs_options<E> const& options = {}) -> distance_matrix<N, E> {
+		auto pool = worker_pool(options.threads);
+		return floyd_warshall(g, pool, options);
+	}
+
+	// All-pairs shortest paths by Johnson's algorithm in O(VE log V), for sparse graphs. One
+	// Bellman-Ford pass finds potentials that make every edge cost non-negative, then Dijkstra
+	// runs from every source over the reweighted costs on pool's workers. Negative weights are
+	// allowed, but throws std::runtime_error if g has a negative cycle.
+	template<typename N, typename E>
+	requires std::is_arithmetic_v<E>
+	auto johnson(graph<N, E> const& g, worker_pool& pool, all_pairs_options<E> const& options = {})
+	    -> distance_matrix<N, E> {
+		using node_id = std::uint32_t;
+		auto matrix = distance_matrix<N, E>(g);
+		auto const n = matrix.node_count();
+		auto offsets = std::vector<std::size_t>(n + 1, 0);
+		auto heads = std::vector<node_id>{};
+		auto costs = std::vector<E>{};
+		heads.reserve(g.edge_count());
+		costs.reserve(g.edge_count());
+		for (auto u = node_id{0}; u < n; ++u) {
+			for (auto const& record : g.out_edges(u)) {
+				heads.push_back(record.dst);
+				costs.push_back(detail::edge_cost(record, options.unweighted_cost));
+			}
+			offsets[u + 1] = heads.size();
+		}
+
+		// Bellman-Ford from a virtual source joined to every node at cost zero.
+		auto potentials = std::vector<E>(n, E{0});
+		auto changed = false;
+		if constexpr (std::is_signed_v<E>) {
+			changed = std::any_of(costs.begin(), costs.end(), [](E const& cost) { return cost < E{0}; });
+		}
+		for (auto round = std::size_t{0}; changed; ++round) {
+			if (round == n) {
+				throw std::runtime_error("Cannot call gdwg::johnson on a graph with a negative cycle");
+			}
+			changed = false;
+			for (auto u = node_id{0}; u < n; ++u) {
+				for (auto a = offsets[u]; a < offsets[u + 1]; ++a) {
+					if (potentials[u] + costs[a] < potentials[heads[a]]) {
+						potentials[heads[a]] = potentials[u] + costs[a];
+						changed = true;
+					}
+				}
+			}
+		}
+		for (auto u = node_id{0}; u < n; ++u) {
+			for (auto a = offsets[u]; a < offsets[u + 1]; ++a) {
+				// Rounding can leave a floating-point cost a hair below zero.
+				costs[a] = std::max(E{0}, costs[a] + potentials[u] - potentials[heads[a]]);
+			}
+		}
+
+		struct scratch {
+			std::vector<E> distances;
+			std::vector<char> settled;
+			detail::binary_heap<E> heap = detail::binary_heap<E>(0);
+		};
+		auto scratches = std::vector<scratch>(pool.size());
+		pool.for_each(
+		    n,
+		    [&](std::size_t worker, std::size_t i) {
+			    auto const source = static_cast<node_id>(i);
+			    auto& [distances, settled, heap] = scratches[worker];
+			    distances.assign(n, infinite_distance<E>);
+			    settled.assign(n, 0);
+			    distances[source] = E{0};
+			    heap.push(source, E{0});
+			    auto row = matrix.row(source);
+			    while (!heap.empty()) {
+				    auto const u = heap.pop();
+				    if (settled[u] != 0) {
+					    continue;
+				    }
+				    settled[u] = 1;
+				    row[u] = distances[u] - potentials[source] + potentials[u];
+				    for (auto a = offsets[u]; a < offsets[u + 1]; ++a) {
+					    auto const candidate = distances[u] + costs[a];
+					    if (candidate < distances[heads[a]]) {
+						    distances[heads[a]] = candidate;
+						    heap.push(heads[a], candidate);
+					    }
+				    }
+			    }
+		    },
+		    1);
+		return matrix;
+	}
+
+	template<typename N, typename E>
+	requires std::is_arithmetic_v<E>
+	auto johnson(graph<N, E> const& g, all_pairs_options<E> const& options = {}) -> distance_matrix<N, E> {
+		auto pool = worker_pool(options.threads);
+		return johnson(g, pool, options);
+	}
+} // namespace gdwg
+
+#endif // GDWG_ALL_PAIRS_H
@@ -0,0 +1,161 @@
+#include "gdwg_all_pairs.h"
+
+#include <catch2/catch.hpp>
+
+#include <optional>
+#include <random>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace {
+	// A random graph whose weights may be negative but form no negative cycle: each weight is a
+	// non-negative base plus a potential difference, which cancels around any cycle.
+	auto random_graph(unsigned seed, int nodes, int edges) -> gdwg::graph<int, long> {
+		auto engine = std::mt19937(seed);
+		auto node = std::uniform_int_distribution<int>(0, nodes - 1);
+		auto base = std::uniform_int_distribution<long>(0, 20);
+		auto potential = std::uniform_int_distribution<long>(0, 30);
+		auto potentials = std::vector<long>(static_cast<std::size_t>(nodes));
+		for (auto& p : potentials) {
+			p = potential(engine);
+		}
+		auto g = gdwg::graph<int, long>{};
+		for (auto i = 0; i < nodes; ++i) {
+			g.insert_node(i * 3);
+		}
+		auto batch = std::vector<std::tuple<int, int, std::optional<long>>>{};
+		for (auto i = 0; i < edges; ++i) {
+			auto const src = node(engine);
+			auto const dst = node(engine);
+			auto const weight = base(engine) + potentials[static_cast<std::size_t>(src)]
+			                    - potentials[static_cast<std::size_t>(dst)];
+			// Left unweighted where the weight is exactly the unweighted cost used below.
+			batch.emplace_back(src * 3, dst * 3, weight == 4 ? std::nullopt : std::optional<long>(weight));
+		}
+		g.insert_edges(batch);
+		return g;
+	}
+
+	// Bellman-Ford from every source, for comparison.
+	auto reference_distances(gdwg::graph<int, long> const& g, long unweighted_cost)
+	    -> std::vector<std::vector<long>> {
+		auto const n = g.node_count();
+		auto const infinite = gdwg::infinite_distance<long>;
+		auto result = std::vector<std::vector<long>>(n, std::vector<long>(n, infinite));
+		for (auto s = std::uint32_t{0}; s < n; ++s) {
+			auto& distances = result[s];
+			distances[s] = 0;
+			for (auto round = std::size_t{0}; round < n; ++round) {
+				for (auto u = std::uint32_t{0}; u < n; ++u) {
+					if (distances[u] == infinite) {
+						continue;
+					}
+					for (auto const& record : g.out_edges(u)) {
+						auto const candidate = distances[u] + record.weight.value_or(unweighted_cost);
+						distances[record.dst] = std::min(distances[record.dst], candidate);
+					}
+				}
+			}
+		}
+		return result;
+	}
+} // namespace
+
+TEST_CASE("All Pairs - Floyd-Warshall And Johnson Match A Reference") {
+	auto const threads = GENERATE(std::size_t{1}, std::size_t{4});
+	auto const block = GENERATE(std::size_t{1}, std::size_t{7}, std::size_t{64});
+	auto const g = random_graph(static_cast<unsigned>(block * 10 + threads), 90, 500);
+	auto pool = gdwg::worker_pool(threads);
+	auto options = gdwg::all_pairs_options<long>{};
+	options.unweighted_cost = 4;
+	options.block = block;
+	auto const expected = reference_distances(g, options.unweighted_cost);
+	auto const dense = gdwg::floyd_warshall(g, pool, options);
+	auto const sparse = gdwg::johnson(g, pool, options);
+	REQUIRE(dense.node_count() == g.node_count());
+	REQUIRE(sparse.node_count() == g.node_count());
+	for (auto u = std::uint32_t{0}; u < g.node_count(); ++u) {
+		for (auto v = std::uint32_t{0}; v < g.node_count(); ++v) {
+			CHECK(dense.distance(u, v) == expected[u][v]);
+			CHECK(sparse.distance(u, v) == expected[u][v]);
+		}
+	}
+}
+
+TEST_CASE("All Pairs - Query By Value Or Id") {
+	auto g = gdwg::graph<std::string, double>{"depot", "mill", "port", "island"};
+	g.insert_edge("depot", "mill", 2.5);
+	g.insert_edge("mill", "port", 1.0);
+	g.insert_edge("depot", "port", 4.0);
+	g.insert_edge("depot", "port", 9.0);
+	g.insert_edge("port", "depot", -1.5);
+	for (auto const& matrix : {gdwg::floyd_warshall(g), gdwg::johnson(g)}) {
+		CHECK(matrix.at("depot", "port") == Approx(3.5));
+		CHECK(matrix.at("port", "mill") == Approx(1.0));
+		CHECK(matrix.at("mill", "mill") == 0.0);
+		CHECK(matrix.at("island", "depot") == gdwg::infinite_distance<double>);
+		auto const island = *matrix.id_of("island");
+		CHECK(matrix.node(island) == "island");
+		CHECK(!matrix.reachable(island, *matrix.id_of("port")));
+		CHECK(matrix.row(*matrix.id_of("mill"))[*matrix.id_of("depot")] == Approx(-0.5));
+		CHECK(!matrix.id_of("harbour"));
+		CHECK_THROWS_MATCHES(
+		    matrix.at("depot", "harbour"),
+		    std::runtime_error,
+		    Catch::Matchers::Message("Cannot call gdwg::distance_matrix<N, E>::at if src or dst node don't exist in "
+		                             "the matrix"));
+	}
+}
+
+TEST_CASE("All Pairs - Integer Weights With Unreachable Pairs") {
+	// The integer sentinel for an unreachable pair must never reach an addition.
+	auto g = gdwg::graph<int, int>{1, 2, 3, 4};
+	g.insert_edge(1, 2, 5);
+	g.insert_edge(3, 1, 1);
+	g.insert_edge(4, 3, -2);
+	auto const infinite = gdwg::infinite_distance<int>;
+	for (auto const& matrix : {gdwg::floyd_warshall(g), gdwg::johnson(g)}) {
+		CHECK(matrix.at(3, 2) == 6);
+		CHECK(matrix.at(4, 2) == 4);
+		CHECK(matrix.at(1, 3) == infinite);
+		CHECK(matrix.at(2, 1) == infinite);
+		CHECK(matrix.at(2, 4) == infinite);
+		CHECK(matrix.at(3, 4) == infinite);
+	}
+}
+
+TEST_CASE("All Pairs - Negative Cycles") {
+	auto g = gdwg::graph<int, int>{1, 2, 3};
+	g.insert_edge(1, 2, 4);
+	g.insert_edge(2, 3, -3);
+	g.insert_edge(3, 2, 5);
+	CHECK(gdwg::floyd_warshall(g).at(1, 3) == 1);
+	CHECK(gdwg::johnson(g).at(3, 2) == 5);
+	g.insert_edge(3, 2, 2);
+	CHECK_THROWS_MATCHES(gdwg::floyd_warshall(g),
+	                     std::runtime_error,
+	                     Catch::Matchers::Message("Cannot call gdwg::floyd_warshall on a graph with a negative cycle"));
+	CHECK_THROWS_MATCHES(gdwg::johnson(g),
+	                     std::runtime_error,
+	                     Catch::Matchers::Message("Cannot call gdwg::johnson on a graph with a negative cycle"));
+	// Every pair is joined by a heavily negative edge, so distances run far past int's range
+	// before the cycle is reported.
+	auto dense = gdwg::graph<int, int>{};
+	for (auto v = 0; v < 96; ++v) {
+		dense.insert_node(v);
+	}
+	for (auto u = 0; u < 96; ++u) {
+		for (auto v = 0; v < 96; ++v) {
+			dense.insert_edge(u, v, -1'000'000);
+		}
+	}
+	auto options = gdwg::all_pairs_options<int>{};
+	options.block = GENERATE(std::size_t{8}, std::size_t{64});
+	CHECK_THROWS_MATCHES(gdwg::floyd_warshall(dense, options),
+	                     std::runtime_error,
+	                     Catch::Matchers::Message("Cannot call gdwg::floyd_warshall on a graph with a negative cycle"));
+	auto const empty = gdwg::graph<int, int>{};
+	CHECK(gdwg::floyd_warshall(empty).node_count() == 0);
+	CHECK(gdwg::johnson(empty).node_count() == 0);
+}
@@ -0,0 +1,597 @@
+#ifndef GDWG_ASTAR_H
+#define GDWG_ASTAR_H
+
+#include "gdwg_graph.h"
+#include "gdwg_parallel.h"
+#include "gdwg_shortest_paths.h"
+#include "gdwg_snapshot.h"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <istream>
+#include <limits>
+#include <numeric>
+#include <ostream>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace gdwg {
+	// Point-to-point shortest path by A*: Dijkstra ordered by distance plus heuristic(id), an
+	// estimate of the distance from id to target. The heuristic must never overestimate, and
+	// infinite_distance marks a node that cannot reach target, which prunes it. A node is settled
+	// at most once if the heuristic is also consistent (never drops by more than an edge's cost),
+	// and reopened when a shorter path turns up otherwise. Stops as soon as target is settled, so
+	// only target's distance and path in the result are final; settled counts the nodes expanded.
+	// Throws std::runtime_error if source or target is not a node, or on a negative edge cost.
+	template<typename N, typename E, typename Heuristic>
+	requires std::is_arithmetic_v<E> and std::is_invocable_r_v<E, Heuristic&, std::uint32_t>
+	auto astar(graph<N, E> const& g,
+	           std::type_identity_t<N> const& source,
+	           std::type_identity_t<N> const& target,
+	           Heuristic heuristic,
+	           std::type_identity_t<E> const& unweighted_cost = E{1}) -> shortest_path_tree<E> {
+		using node_id = std::uint32_t;
+		constexpr auto infinite = infinite_distance<E>;
+		auto const src = detail::id_or_throw(g, source, "Cannot call gdwg::astar if source doesn't exist in the graph");
+		auto const dst = detail::id_or_throw(g, target, "Cannot call gdwg::astar if target doesn't exist in the graph");
+		auto const n = g.node_count();
+		auto tree = shortest_path_tree<E>{};
+		tree.source = src;
+		tree.distances.assign(n, infinite);
+		tree.predecessors.assign(n, shortest_path_tree<E>::no_node);
+		auto closed = std::vector<char>(n, 0);
+		auto heap = detail::binary_heap<E>(n);
+		tree.distances[src] = E{0};
+		if (auto const estimate = heuristic(src); estimate != infinite) {
+			heap.push(src, estimate);
+		}
+		while (!heap.empty()) {
+			auto const u = heap.pop();
+			if (closed[u] != 0) {
+				continue;
+			}
+			closed[u] = 1;
+			++tree.settled;
+			if (u == dst) {
+				break;
+			}
+			for (auto const& record : g.out_edges(u)) {
+				auto const cost = detail::edge_cost(record, unweighted_cost);
+				detail::check_non_negative(cost, "gdwg::astar");
+				auto const v = record.dst;
+				auto const candidate = tree.distances[u] + cost;
+				if (!(candidate < tree.distances[v])) {
+					continue;
+				}
+				tree.distances[v] = candidate;
+				tree.predecessors[v] = u;
+				if (auto const estimate = heuristic(node_id{v}); estimate != infinite) {
+					closed[v] = 0;
+					heap.push(v, candidate + estimate);
+				}
+			}
+		}
+		return tree;
+	}
+
+	template<typename E>
+	struct landmark_options {
+		// How many landmarks to pick. Fewer if the graph has fewer nodes.
+		std::size_t count = 16;
+		// The cost of traversing an unweighted edge.
+		E unweighted_cost = E{1};
+		// Threads used to compute the tables. Zero uses every hardware thread.
+		std::size_t threads = 0;
+	};
+
+	// Precomputed distances from and to a few landmark nodes, which give A* a lower bound on the
+	// distance between any two nodes by the triangle inequality (the ALT heuristic). Indexed by
+	// the dense node ids of the graph it was built from, whose node and edge counts it records so
+	// that a table used with a different graph is caught. Saved tables do not depend on those ids,
+	// so a table can be reloaded for an equal graph that numbers its nodes differently.
+	template<typename E>
+	class landmark_table {
+	 public:
+		using node_id = std::uint32_t;
+
+		// Constructors and Destructors
+		landmark_table() = default;
+
+		// from[i * node_count + v] is the distance from landmark i to v, and to[i * node_count + v]
+		// the distance from v to landmark i.
+		landmark_table(std::vector<node_id> landmarks,
+		               std::size_t node_count,
+		               std::size_t edge_count,
+		               std::vector<E> from,
+		               std::vector<E> to)
+		: landmarks_(std::move(landmarks))
+		, node_count_(node_count)
+		, edge_count_(edge_count)
+		, from_(std::move(from))
+		, to_(std::move(to)) {
+			if (from_.size() != landmarks_.size() * node_count_ or to_.size() != from_.size()) {
+				throw std::runtime_error("Cannot create gdwg::landmark_table when the tables do not match the "
+				                         "landmark and node counts");
+			}
+		}
+
+		// Accessors
+		[[nodiscard]] auto landmarks() const noexcept -> std::span<node_id const> {
+			return landmarks_;
+		}
+
+		[[nodiscard]] auto node_count() const noexcept -> std::size_t {
+			return node_count_;
+		}
+
+		[[nodiscard]] auto edge_count() const noexcept -> std::size_t {
+			return edge_count_;
+		}
+
+		[[nodiscard]] auto from_landmark(std::size_t landmark, node_id v) const -> E {
+			return from_[landmark * node_count_ + v];
+		}
+
+		[[nodiscard]] auto to_landmark(std::size_t landmark, node_id v) const -> E {
+			return to_[landmark * node_count_ + v];
+		}
+
+		[[nodiscard]] auto from_table() const noexcept -> std::span<E const> {
+			return from_;
+		}
+
+		[[nodiscard]] auto to_table() const noexcept -> std::span<E const> {
+			return to_;
+		}
+
+		// A lower bound on the distance from one node to another, or infinite_distance if the
+		// landmarks prove there is no path. For each landmark L, d(from, to) is at least
+		// d(L, to) - d(L, from) and d(from, L) - d(to, L).
+		[[nodiscard]] auto lower_bound(node_id from, node_id to) const -> E {
+			constexpr auto infinite = infinite_distance<E>;
+			auto bound = E{0};
+			for (auto i = std::size_t{0}; i < landmarks_.size(); ++i) {
+				auto const from_l_to = from_landmark(i, to);
+				auto const from_l_from = from_landmark(i, from);
+				auto const to_l_from = to_landmark(i, from);
+				auto const to_l_to = to_landmark(i, to);
+				if (from_l_from != infinite) {
+					// L reaches from, so if L cannot reach to, neither can from.
+					if (from_l_to == infinite) {
+						return infinite;
+					}
+					if (from_l_to > from_l_from) {
+						bound = std::max(bound, static_cast<E>(from_l_to - from_l_from));
+					}
+				}
+				if (to_l_to != infinite) {
+					// to reaches L, so if from cannot reach L, it cannot reach to.
+					if (to_l_from == infinite) {
+						return infinite;
+					}
+					if (to_l_from > to_l_to) {
+						bound = std::max(bound, static_cast<E>(to_l_from - to_l_to));
+					}
+				}
+			}
+			return bound;
+		}
+
+		friend auto operator==(landmark_table const& lhs, landmark_table const& rhs) -> bool = default;
+
+	 private:
+		std::vector<node_id> landmarks_;
+		std::size_t node_count_ = 0;
+		std::size_t edge_count_ = 0;
+		std::vector<E> from_;
+		std::vector<E> to_;
+	};
+
+	namespace detail {
+		// Dijkstra from source over flat edge arrays, returning every distance.
+		template<typename E>
+		auto flat_distances(cheapest_edges<E> const& edges, std::uint32_t source) -> std::vector<E> {
+			auto const n = edges.offsets.size() - 1;
+			auto distances = std::vector<E>(n, infinite_distance<E>);
+			auto settled = std::vector<char>(n, 0);
+			auto heap = binary_heap<E>(n);
+			distances[source] = E{0};
+			heap.push(source, E{0});
+			while (!heap.empty()) {
+				auto const u = heap.pop();
+				if (settled[u] != 0) {
+					continue;
+				}
+				settled[u] = 1;
+				for (auto a = edges.offsets[u]; a < edges.offsets[u + 1]; ++a) {
+					auto const candidate = distances[u] + edges.costs[a];
+					if (candidate < distances[edges.heads[a]]) {
+						distances[edges.heads[a]] = candidate;
+						heap.push(edges.heads[a], candidate);
+					}
+				}
+			}
+			return distances;
+		}
+
+		template<typename E>
+		auto reverse_edges(cheapest_edges<E> const& edges) -> cheapest_edges<E> {
+			auto const n = edges.offsets.size() - 1;
+			auto reversed = cheapest_edges<E>{};
+			reversed.offsets.assign(n + 1, 0);
+			for (auto head : edges.heads) {
+				++reversed.offsets[head + 1];
+			}
+			for (auto v = std::size_t{0}; v < n; ++v) {
+				reversed.offsets[v + 1] += reversed.offsets[v];
+			}
+			reversed.heads.resize(edges.heads.size());
+			reversed.costs.resize(edges.costs.size());
+			auto cursor = std::vector<std::size_t>(reversed.offsets.begin(), reversed.offsets.end() - 1);
+			for (auto u = std::uint32_t{0}; u < n; ++u) {
+				for (auto a = edges.offsets[u]; a < edges.offsets[u + 1]; ++a) {
+					auto const slot = cursor[edges.heads[a]]++;
+					reversed.heads[slot] = u;
+					reversed.costs[slot] = edges.costs[a];
+				}
+			}
+			return reversed;
+		}
+
+		template<typename N, typename E>
+		auto make_landmark_table(graph<N, E> const& g,
+		                         std::vector<std::uint32_t> landmarks,
+		                         std::vector<E> from,
+		                         cheapest_edges<E> const& edges,
+		                         std::size_t threads) -> landmark_table<E> {
+			auto const n = g.node_count();
+			from.resize(landmarks.size() * n);
+			auto to = std::vector<E>(landmarks.size() * n);
+			auto const reversed = reverse_edges(edges);
+			auto pool = worker_pool(threads);
+			pool.for_each(
+			    landmarks.size(),
+			    [&](std::size_t, std::size_t i) {
+				    auto const into = flat_distances(reversed, landmarks[i]);
+				    std::copy(into.begin(), into.end(), to.begin() + static_cast<std::ptrdiff_t>(i * n));
+			    },
+			    1);
+			return landmark_table<E>(std::move(landmarks), n, g.edge_count(), std::move(from), std::move(to));
+		}
+
+		template<typename N, typename E>
+		auto landmark_edges(graph<N, E> const& g, E const& unweighted_cost) -> cheapest_edges<E> {
+			auto edges = make_cheapest_edges(g, unweighted_cost);
+			for (auto const& cost : edges.costs) {
+				check_non_negative(cost, "gdwg::make_landmark_table");
+			}
+			return edges;
+		}
+	} // namespace detail
+
+	// Picks options.count landmarks by farthest selection and computes their tables. Each new
+	// landmark is the node farthest from all landmarks so far, or a node none of them reaches, so
+	// landmarks spread to the edges of the graph where their bounds are tightest. Throws
+	// std::runtime_error on a negative edge cost.
+	template<typename N, typename E>
+	requires std::is_arithmetic_v<E>
+	auto make_landmark_table(graph<N, E> const& g, landmark_options<E> const& options = {}) -> landmark_table<E> {
+		auto const n = g.node_count();
+		auto const edges = detail::landmark_edges(g, options.unweighted_cost);
+		auto const count = std::min(options.count, n);
+		auto landmarks = std::vector<std::uint32_t>{};
+		auto from = std::vector<E>{};
+		from.reserve(count * n);
+		// The distance from the nearest landmark so far, starting from node 0 as a stand-in.
+		auto nearest = n == 0 ? std::vector<E>{} : detail::flat_distances(edges, 0);
+		auto chosen = std::vector<char>(n, 0);
+		while (landmarks.size() < count) {
+			auto best = shortest_path_tree<E>::no_node;
+			for (auto v = std::uint32_t{0}; v < n; ++v) {
+				if (chosen[v] == 0 and (best == shortest_path_tree<E>::no_node or nearest[best] < nearest[v])) {
+					best = v;
+				}
+			}
+			chosen[best] = 1;
+			landmarks.push_back(best);
+			auto const distances = detail::flat_distances(edges, best);
+			from.insert(from.end(), distances.begin(), distances.end());
+			for (auto v = std::uint32_t{0}; v < n; ++v) {
+				nearest[v] = std::min(nearest[v], distances[v]);
+			}
+		}
+		return detail::make_landmark_table(g, std::move(landmarks), std::move(from), edges, options.threads);
+	}
+
+	// Computes tables for the given landmarks. options.count is ignored.
+	template<typename N, typename E>
+	requires std::is_arithmetic_v<E>
+	auto make_landmark_table(graph<N, E> const& g,
+	                         std::vector<N> const& landmarks,
+	                         landmark_options<E> const& options = {}) -> landmark_table<E> {
+		auto ids = std::vector<std::uint32_t>{};
+		constexpr auto missing = "Cannot call gdwg::make_landmark_table if a landmark doesn't exist in the graph";
+		for (auto const& landmark : landmarks) {
+			ids.push_back(detail::id_or_throw(g, landmark, missing));
+		}
+		auto const edges = detail::landmark_edges(g, options.unweighted_cost);
+		auto from = std::vector<E>{};
+		from.reserve(ids.size() * g.node_count());
+		for (auto id : ids) {
+			auto const distances = detail::flat_distances(edges, id);
+			from.insert(from.end(), distances.begin(), distances.end());
+		}
+		return detail::make_landmark_table(g, std::move(ids), std::move(from), edges, options.threads);
+	}
+
+	// A* with the ALT heuristic from table, which must have been built from g with the same
+	// unweighted_cost. Throws std::runtime_error if table's node or edge count differs from g's.
+	template<typename N, typename E>
+	requires std::is_arithmetic_v<E>
+	auto astar(graph<N, E> const& g,
+	           std::type_identity_t<N> const& source,
+	           std::type_identity_t<N> const& target,
+	           landmark_table<E> const& table,
+	           std::type_identity_t<E> const& unweighted_cost = E{1}) -> shortest_path_tree<E> {
+		if (table.node_count() != g.node_count() or table.edge_count() != g.edge_count()) {
+			throw std::runtime_error("Cannot call gdwg::astar with a landmark table built for a different graph");
+		}
+		auto const dst = detail::id_or_throw(g, target, "Cannot call gdwg::astar if target doesn't exist in the graph");
+		return astar(
+		    g,
+		    source,
+		    target,
+		    [&table, dst](std::uint32_t v) { return table.lower_bound(v, dst); },
+		    unweighted_cost);
+	}
+
+	// A landmark table file is a fixed header followed by the landmarks and the from and to tables,
+	// unpadded, in native byte order and layout like a snapshot. Ids depend on the order nodes were
+	// inserted in, so the file indexes nodes by their position in value order instead, and records a
+	// fingerprint of the graph's edges in the same terms. Loading checks the fingerprint against the
+	// graph it is given and maps positions back to that graph's ids.
+	namespace detail {
+		inline constexpr auto landmark_magic = std::array<char, 8>{'G', 'D', 'W', 'G', 'L', 'M', 'R', 'K'};
+		inline constexpr auto landmark_version = std::uint32_t{2};
+
+		struct landmark_header {
+			std::array<char, 8> magic;
+			std::uint32_t version;
+			std::uint32_t byte_order;
+			std::uint32_t weight_size;
+			std::uint32_t reserved;
+			std::uint64_t node_count;
+			std::uint64_t edge_count;
+			std::uint64_t landmark_count;
+			// Of the graph the table was built from; see landmark_fingerprint.
+			std::uint64_t fingerprint;
+			// Of the landmarks, the from table and the to table.
+			std::array<std::uint64_t, 3> checksums;
+			// Covers every field above it.
+			std::uint64_t header_checksum;
+		};
+		static_assert(std::is_trivially_copyable_v<landmark_header>);
+
+		inline auto header_checksum(landmark_header const& header) noexcept -> std::uint64_t {
+			auto const* first = reinterpret_cast<std::byte const*>(&header);
+			return snapshot_checksum({first, offsetof(landmark_header, header_checksum)});
+		}
+
+		// The ids of g in ascending value order.
+		template<typename N, typename E>
+		auto value_order(graph<N, E> const& g) -> std::vector<std::uint32_t> {
+			auto order = std::vector<std::uint32_t>(g.node_count());
+			std::iota(order.begin(), order.end(), std::uint32_t{0});
+			std::sort(order.begin(), order.end(), [&g](auto lhs, auto rhs) { return g.node(lhs) < g.node(rhs); });
+			return order;
+		}
+
+		template<typename T>
+		auto fingerprint_add(std::uint64_t hash, T const& value) noexcept -> std::uint64_t {
+			auto bytes = std::array<std::byte, sizeof(T)>{};
+			std::memcpy(bytes.data(), &value, sizeof(T));
+			for (auto byte : bytes) {
+				hash = (hash ^ static_cast<std::uint64_t>(byte)) * std::uint64_t{0x100000001b3};
+			}
+			return hash;
+		}
+
+		// FNV-1a over every node's out-degree and edges, visiting nodes in value order and naming
+		// destinations by their position in it. Graphs that compare equal share a fingerprint
+		// whatever ids they assign.
+		template<typename N, typename E>
+		auto landmark_fingerprint(graph<N, E> const& g, std::span<std::uint32_t const> order) -> std::uint64_t {
+			auto position = std::vector<std::uint32_t>(order.size());
+			for (auto i = std::size_t{0}; i < order.size(); ++i) {
+				position[order[i]] = static_cast<std::uint32_t>(i);
+			}
+			auto hash = std::uint64_t{0xcbf29ce484222325};
+			for (auto const u : order) {
+				auto const edges = g.out_edges(u);
+				hash = fingerprint_add(hash, std::uint64_t{edges.size()});
+				for (auto const& record : edges) {
+					hash = fingerprint_add(hash, position[record.dst]);
+					hash = fingerprint_add(hash, record.weight.has_value());
+					hash = fingerprint_add(hash, record.weight.value_or(E{0}));
+				}
+			}
+			return hash;
+		}
+	} // namespace detail
+
+	// Writes table, which must have been built from g, to os. Throws std::runtime_error if it was
+	// built for a graph of a different size, or if the stream fails.
+	template<typename N, typename E>
+	requires std::is_arithmetic_v<E>
+	auto save_landmarks(landmark_table<E> const& table, graph<N, E> const& g, std::ostream& os) -> void {
+		using namespace detail;
+		auto const n = g.node_count();
+		if (table.node_count() != n or table.edge_count() != g.edge_count()) {
+			throw std::runtime_error("Cannot call gdwg::save_landmarks with a landmark table built for a different "
+			                         "graph");
+		}
+		auto const order = value_order(g);
+		auto position = std::vector<std::uint32_t>(n);
+		for (auto i = std::size_t{0}; i < n; ++i) {
+			position[order[i]] = static_cast<std::uint32_t>(i);
+		}
+		auto landmarks = std::vector<std::uint32_t>{};
+		for (auto const landmark : table.landmarks()) {
+			landmarks.push_back(position[landmark]);
+		}
+		auto from = std::vector<E>(table.from_table().size());
+		auto to = std::vector<E>(table.to_table().size());
+		for (auto i = std::size_t{0}; i < landmarks.size(); ++i) {
+			for (auto v = std::size_t{0}; v < n; ++v) {
+				from[i * n + v] = table.from_landmark(i, order[v]);
+				to[i * n + v] = table.to_landmark(i, order[v]);
+			}
+		}
+
+		auto const sections = std::array<std::span<std::byte const>, 3>{
+		    std::as_bytes(std::span<std::uint32_t const>(landmarks)),
+		    std::as_bytes(std::span<E const>(from)),
+		    std::as_bytes(std::span<E const>(to)),
+		};
+		auto header = landmark_header{};
+		header.magic = landmark_magic;
+		header.version = landmark_version;
+		header.byte_order = snapshot_byte_order;
+		header.weight_size = static_cast<std::uint32_t>(sizeof(E));
+		header.node_count = n;
+		header.edge_count = g.edge_count();
+		header.landmark_count = landmarks.size();
+		header.fingerprint = landmark_fingerprint(g, order);
+		for (auto i = std::size_t{0}; i < sections.size(); ++i) {
+			header.checksums[i] = snapshot_checksum(sections[i]);
+		}
+		header.header_checksum = header_checksum(header);
+		os.write(reinterpret_cast<char const*>(&header), sizeof(header));
+		for (auto const& section : sections) {
+			os.write(reinterpret_cast<char const*>(section.data()), static_cast<std::streamsize>(section.size()));
+		}
+		if (!os) {
+			throw std::runtime_error("Cannot call gdwg::save_landmarks when the output stream fails");
+		}
+	}
+
+	template<typename N, typename E>
+	requires std::is_arithmetic_v<E>
+	auto save_landmarks(landmark_table<E> const& table, graph<N, E> const& g, std::string const& path) -> void {
+		auto file = std::ofstream(path, std::ios::binary | std::ios::trunc);
+		if (!file) {
+			throw std::runtime_error("Cannot call gdwg::save_landmarks when the file cannot be opened: " + path);
+		}
+		save_landmarks(table, g, file);
+	}
+
+	// Reads a table written by save_landmarks for a graph equal to g, indexed by g's ids. Throws
+	// std::runtime_error if the input is not a landmark table for this weight type and byte order,
+	// is truncated, has counts its sections cannot hold, fails its checksums, or was written for a
+	// different graph.
+	template<typename N, typename E>
+	requires std::is_arithmetic_v<E>
+	auto load_landmarks(std::istream& is, graph<N, E> const& g) -> landmark_table<E> {
+		using namespace detail;
+		auto const malformed = [] {
+			throw std::runtime_error("Cannot call gdwg::load_landmarks when the input is truncated or its sections "
+			                         "are malformed");
+		};
+		auto header = landmark_header{};
+		if (!is.read(reinterpret_cast<char*>(&header), sizeof(header))) {
+			malformed();
+		}
+		if (header.magic != landmark_magic or header.version != landmark_version
+		    or header.byte_order != snapshot_byte_order or header.weight_size != sizeof(E)
+		    or header.header_checksum != header_checksum(header))
+		{
+			throw std::runtime_error("Cannot call gdwg::load_landmarks when the input is not a landmark table");
+		}
+		// Bound the counts before allocating anything: landmarks are distinct nodes, and the
+		// tables they imply must neither overflow nor run past the end of a seekable input.
+		constexpr auto max_entries = std::numeric_limits<std::uint64_t>::max() / 4 / sizeof(E);
+		if (header.node_count > std::numeric_limits<std::uint32_t>::max() or header.landmark_count > header.node_count
+		    or (header.landmark_count != 0 and header.node_count > max_entries / header.landmark_count))
+		{
+			malformed();
+		}
+		auto const entries = header.landmark_count * header.node_count;
+		auto const needed = header.landmark_count * sizeof(std::uint32_t) + 2 * entries * sizeof(E);
+		if (auto const start = is.tellg(); start != std::istream::pos_type(-1)) {
+			is.seekg(0, std::ios::end);
+			auto const remaining = static_cast<std::uint64_t>(is.tellg() - start);
+			is.seekg(start);
+			if (needed > remaining) {
+				malformed();
+			}
+		}
+		auto const n = g.node_count();
+		auto const order = value_order(g);
+		if (header.node_count != n or header.edge_count != g.edge_count()
+		    or header.fingerprint != landmark_fingerprint(g, order))
+		{
+			throw std::runtime_error("Cannot call gdwg::load_landmarks with a landmark table built for a different "
+			                         "graph");
+		}
+		// Grown a chunk at a time, so an input that cannot seek fails on its missing bytes before
+		// a bad count can allocate far past them.
+		auto const read = [&is, &malformed]<typename T>(std::vector<T>& values, std::size_t count) {
+			constexpr auto chunk = std::size_t{1} << 16;
+			while (values.size() < count) {
+				auto const first = values.size();
+				values.resize(first + std::min(chunk, count - first));
+				auto const bytes = static_cast<std::streamsize>((values.size() - first) * sizeof(T));
+				if (!is.read(reinterpret_cast<char*>(values.data() + first), bytes)) {
+					malformed();
+				}
+			}
+		};
+		auto landmarks = std::vector<std::uint32_t>{};
+		auto positioned_from = std::vector<E>{};
+		auto positioned_to = std::vector<E>{};
+		read(landmarks, header.landmark_count);
+		read(positioned_from, entries);
+		read(positioned_to, entries);
+		if (snapshot_checksum(std::as_bytes(std::span<std::uint32_t const>(landmarks))) != header.checksums[0]
+		    or snapshot_checksum(std::as_bytes(std::span<E const>(positioned_from))) != header.checksums[1]
+		    or snapshot_checksum(std::as_bytes(std::span<E const>(positioned_to))) != header.checksums[2])
+		{
+			throw std::runtime_error("Cannot call gdwg::load_landmarks when a checksum does not match");
+		}
+
+		// Positions in value order become g's ids.
+		auto from = std::vector<E>(entries);
+		auto to = std::vector<E>(entries);
+		for (auto i = std::size_t{0}; i < landmarks.size(); ++i) {
+			if (landmarks[i] >= n) {
+				malformed();
+			}
+			landmarks[i] = order[landmarks[i]];
+			for (auto v = std::size_t{0}; v < n; ++v) {
+				from[i * n + order[v]] = positioned_from[i * n + v];
+				to[i * n + order[v]] = positioned_to[i * n + v];
+			}
+		}
+		return landmark_table<E>(std::move(landmarks), n, g.edge_count(), std::move(from), std::move(to));
+	}
+
+	template<typename N, typename E>
+	requires std::is_arithmetic_v<E>
+	auto load_landmarks(std::string const& path, graph<N, E> const& g) -> landmark_table<E> {
+		auto file = std::ifstream(path, std::ios::binary);
+		if (!file) {
+			throw std::runtime_error("Cannot call gdwg::load_landmarks when the file cannot be opened: " + path);
+		}
+		return load_landmarks(file, g);
+	}
+} // namespace gdwg
+
+#endif // GDWG_ASTAR_H
@@ -0,0 +1,347 @@
+#include "gdwg_astar.h"
+
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+	constexpr auto side = 40;
+
+	// A side by side grid joined both ways, like a road network, with random costs in [1, 10].
+	auto road_grid(unsigned seed) -> gdwg::graph<int, int> {
+		auto engine = std::mt19937(seed);
+		auto weight = std::uniform_int_distribution<int>(1, 10);
+		auto g = gdwg::graph<int, int>{};
+		for (auto i = 0; i < side * side; ++i) {
+			g.insert_node(i);
+		}
+		for (auto row = 0; row < side; ++row) {
+			for (auto col = 0; col < side; ++col) {
+				auto const here = row * side + col;
+				if (col + 1 < side) {
+					g.insert_edge(here, here + 1, weight(engine));
+					g.insert_edge(here + 1, here, weight(engine));
+				}
+				if (row + 1 < side) {
+					g.insert_edge(here, here + side, weight(engine));
+					g.insert_edge(here + side, here, weight(engine));
+				}
+			}
+		}
+		return g;
+	}
+
+	auto random_queries(unsigned seed, int count) -> std::vector<std::pair<int, int>> {
+		auto engine = std::mt19937(seed);
+		auto node = std::uniform_int_distribution<int>(0, side * side - 1);
+		auto queries = std::vector<std::pair<int, int>>{};
+		for (auto i = 0; i < count; ++i) {
+			queries.emplace_back(node(engine), node(engine));
+		}
+		return queries;
+	}
+} // namespace
+
+TEST_CASE("A* - Zero Heuristic Matches Dijkstra") {
+	auto const g = road_grid(1);
+	for (auto const& [source, target] : random_queries(2, 20)) {
+		auto const expected = gdwg::dijkstra(g, source, target);
+		auto const tree = gdwg::astar(g, source, target, [](std::uint32_t) { return 0; });
+		auto const id = *g.id_of(target);
+		CHECK(tree.distances[id] == expected.distances[id]);
+		CHECK(tree.settled == expected.settled);
+	}
+}
+
+TEST_CASE("A* - Manhattan Heuristic On A Grid") {
+	auto const g = road_grid(3);
+	for (auto const& [source, target] : random_queries(4, 20)) {
+		auto const expected = gdwg::dijkstra(g, source, target);
+		// Every edge costs at least one, so the grid distance never overestimates.
+		auto const tree = gdwg::astar(g, source, target, [&g, target](std::uint32_t v) {
+			auto const node = g.node(v);
+			return std::abs(node / side - target / side) + std::abs(node % side - target % side);
+		});
+		auto const id = *g.id_of(target);
+		CHECK(tree.distances[id] == expected.distances[id]);
+		CHECK(tree.settled <= expected.settled);
+		auto const path = tree.path_to(id);
+		REQUIRE(!path.empty());
+		CHECK(g.node(path.front()) == source);
+		CHECK(g.node(path.back()) == target);
+	}
+}
+
+TEST_CASE("A* - Inconsistent Heuristic Reopens Nodes") {
+	auto const g = road_grid(5);
+	auto engine = std::mt19937(6);
+	for (auto const& [source, target] : random_queries(7, 20)) {
+		// Random fractions of the true remaining distance are admissible but not consistent.
+		auto const reverse = gdwg::make_landmark_table(g, std::vector<int>{target});
+		auto fraction = std::uniform_int_distribution<int>(0, 4);
+		auto estimates = std::vector<int>(g.node_count());
+		for (auto v = std::uint32_t{0}; v < g.node_count(); ++v) {
+			estimates[v] = reverse.to_landmark(0, v) * fraction(engine) / 4;
+		}
+		auto const tree = gdwg::astar(g, source, target, [&estimates](std::uint32_t v) { return estimates[v]; });
+		auto const id = *g.id_of(target);
+		CHECK(tree.distances[id] == reverse.to_landmark(0, *g.id_of(source)));
+	}
+}
+
+TEST_CASE("A* - Unreachable Target") {
+	auto const g = gdwg::graph<int, int>{1, 2, 3};
+	auto const tree = gdwg::astar(g, 1, 3, [](std::uint32_t) { return 0; });
+	CHECK(!tree.reached(*g.id_of(3)));
+	CHECK(tree.path_to(*g.id_of(3)).empty());
+}
+
+TEST_CASE("A* - Errors") {
+	auto g = gdwg::graph<int, int>{1, 2};
+	auto const zero = [](std::uint32_t) { return 0; };
+	CHECK_THROWS_MATCHES(gdwg::astar(g, 3, 1, zero),
+	                     std::runtime_error,
+	                     Catch::Matchers::Message("Cannot call gdwg::astar if source doesn't exist in the graph"));
+	CHECK_THROWS_MATCHES(gdwg::astar(g, 1, 3, zero),
+	                     std::runtime_error,
+	                     Catch::Matchers::Message("Cannot call gdwg::astar if target doesn't exist in the graph"));
+	g.insert_edge(1, 2, -1);
+	CHECK_THROWS_MATCHES(gdwg::astar(g, 1, 2, zero),
+	                     std::runtime_error,
+	                     Catch::Matchers::Message("Cannot call gdwg::astar on a graph with negative edge weights"));
+}
+
+TEST_CASE("ALT - Lower Bounds Never Overestimate") {
+	auto const g = road_grid(8);
+	auto options = gdwg::landmark_options<int>{};
+	options.count = 6;
+	auto const table = gdwg::make_landmark_table(g, options);
+	CHECK(table.landmarks().size() == 6);
+	for (auto const& [source, target] : random_queries(9, 20)) {
+		// Landmarks' own tables are exact distances, here from source and to target.
+		auto const exact = gdwg::make_landmark_table(g, std::vector<int>{source, target});
+		auto const src = *g.id_of(source);
+		auto const dst = *g.id_of(target);
+		for (auto v = std::uint32_t{0}; v < g.node_count(); ++v) {
+			CHECK(table.lower_bound(src, v) <= exact.from_landmark(0, v));
+			CHECK(table.lower_bound(v, dst) <= exact.to_landmark(1, v));
+		}
+	}
+}
+
+TEST_CASE("ALT - Matches Dijkstra And Settles Fewer Nodes") {
+	auto const g = road_grid(10);
+	auto const table = gdwg::make_landmark_table(g);
+	auto dijkstra_settled = std::size_t{0};
+	auto alt_settled = std::size_t{0};
+	for (auto const& [source, target] : random_queries(11, 50)) {
+		auto const expected = gdwg::dijkstra(g, source, target);
+		auto const tree = gdwg::astar(g, source, target, table);
+		auto const id = *g.id_of(target);
+		CHECK(tree.distances[id] == expected.distances[id]);
+		dijkstra_settled += expected.settled;
+		alt_settled += tree.settled;
+	}
+	CHECK(alt_settled * 4 < dijkstra_settled);
+}
+
+TEST_CASE("ALT - Chosen Landmarks And Unreachable Pairs") {
+	// Two strongly connected halves, with only the first reaching the second.
+	auto g = gdwg::graph<std::string, double>{"a", "b", "c", "d"};
+	g.insert_edge("a", "b", 1.5);
+	g.insert_edge("b", "a", 2.0);
+	g.insert_edge("b", "c", 4.0);
+	g.insert_edge("c", "d", 0.5);
+	g.insert_edge("d", "c", 1.0);
+	auto const table = gdwg::make_landmark_table(g, std::vector<std::string>{"c"});
+	REQUIRE(table.landmarks().size() == 1);
+	CHECK(g.node(table.landmarks()[0]) == "c");
+	CHECK(table.lower_bound(*g.id_of("d"), *g.id_of("a")) == gdwg::infinite_distance<double>);
+	CHECK(table.lower_bound(*g.id_of("a"), *g.id_of("d")) <= 6.0);
+	auto const tree = gdwg::astar(g, "d", "a", table);
+	CHECK(!tree.reached(*g.id_of("a")));
+	CHECK(gdwg::astar(g, "a", "d", table).distances[*g.id_of("d")] == 6.0);
+	// More landmarks than nodes picks every node once.
+	auto options = gdwg::landmark_options<double>{};
+	options.count = 10;
+	auto const all = gdwg::make_landmark_table(g, options);
+	auto chosen = std::vector<std::uint32_t>(all.landmarks().begin(), all.landmarks().end());
+	std::sort(chosen.begin(), chosen.end());
+	CHECK(chosen == std::vector<std::uint32_t>{0, 1, 2, 3});
+}
+
+TEST_CASE("ALT - Serialization Round Trip") {
+	auto const g = road_grid(12);
+	auto options = gdwg::landmark_options<int>{};
+	options.count = 4;
+	auto const table = gdwg::make_landmark_table(g, options);
+	auto buffer = std::stringstream(std::ios::in | std::ios::out | std::ios::binary);
+	gdwg::save_landmarks(table, g, buffer);
+	auto const loaded = gdwg::load_landmarks(buffer, g);
+	CHECK(loaded == table);
+	for (auto const& [source, target] : random_queries(13, 10)) {
+		auto const id = *g.id_of(target);
+		auto const expected = gdwg::astar(g, source, target, table);
+		auto const tree = gdwg::astar(g, source, target, loaded);
+		CHECK(tree.distances[id] == expected.distances[id]);
+		CHECK(tree.settled == expected.settled);
+	}
+}
+
+TEST_CASE("ALT - Reloaded Through A Snapshot") {
+	// Nodes inserted in shuffled order get different ids once a snapshot reloads them in value order.
+	auto engine = std::mt19937(29);
+	auto values = std::vector<int>(60);
+	std::iota(values.begin(), values.end(), 0);
+	std::shuffle(values.begin(), values.end(), engine);
+	auto g = gdwg::graph<int, int>{};
+	g.insert_nodes(values);
+	auto node = std::uniform_int_distribution<int>(0, 59);
+	auto weight = std::uniform_int_distribution<int>(1, 20);
+	while (g.edge_count() < 240) {
+		g.insert_edge(node(engine), node(engine), weight(engine));
+	}
+	auto options = gdwg::landmark_options<int>{};
+	options.count = 4;
+	auto const table = gdwg::make_landmark_table(g, options);
+
+	auto const path = (std::filesystem::temp_directory_path() / "gdwg_astar_test_reload").string();
+	gdwg::save_snapshot(g, path);
+	auto const reloaded = gdwg::load_snapshot<int, int>(path);
+	std::filesystem::remove(path);
+	REQUIRE(reloaded == g);
+	REQUIRE(reloaded.id_of(values[0]) != g.id_of(values[0]));
+
+	auto buffer = std::stringstream(std::ios::in | std::ios::out | std::ios::binary);
+	gdwg::save_landmarks(table, g, buffer);
+	auto const loaded = gdwg::load_landmarks(buffer, reloaded);
+	for (auto const source : values) {
+		auto const expected = gdwg::dijkstra(reloaded, source);
+		for (auto const target : values) {
+			auto const id = *reloaded.id_of(target);
+			CHECK(gdwg::astar(reloaded, source, target, loaded).distances[id] == expected.distances[id]);
+		}
+	}
+}
+
+TEST_CASE("ALT - Errors") {
+	auto g = road_grid(14);
+	auto options = gdwg::landmark_options<int>{};
+	options.count = 2;
+	auto const table = gdwg::make_landmark_table(g, options);
+	auto out = std::ostringstream(std::ios::binary);
+	gdwg::save_landmarks(table, g, out);
+	auto const bytes = out.str();
+
+	SECTION("Corrupted tables") {
+		auto corrupted = bytes;
+		corrupted[corrupted.size() / 2] = static_cast<char>(corrupted[corrupted.size() / 2] ^ 1);
+		auto in = std::istringstream(corrupted, std::ios::binary);
+		CHECK_THROWS_MATCHES(gdwg::load_landmarks(in, g),
+		                     std::runtime_error,
+		                     Catch::Matchers::Message("Cannot call gdwg::load_landmarks when a checksum does not "
+		                                              "match"));
+	}
+
+	SECTION("Truncated tables") {
+		auto in = std::istringstream(bytes.substr(0, bytes.size() - 1), std::ios::binary);
+		CHECK_THROWS_MATCHES(gdwg::load_landmarks(in, g),
+		                     std::runtime_error,
+		                     Catch::Matchers::Message("Cannot call gdwg::load_landmarks when the input is truncated or "
+		                                              "its sections are malformed"));
+	}
+
+	SECTION("Corrupted headers") {
+		// Counts rewritten with a freshly computed header checksum must fail before allocating.
+		auto const reseal = [&bytes](auto edit) {
+			auto header = gdwg::detail::landmark_header{};
+			std::memcpy(&header, bytes.data(), sizeof(header));
+			edit(header);
+			header.header_checksum = gdwg::detail::header_checksum(header);
+			auto edited = bytes;
+			std::memcpy(edited.data(), &header, sizeof(header));
+			return edited;
+		};
+		auto const huge = std::uint64_t{1} << 40;
+		auto const edits = std::vector<std::string>{
+		    reseal([](gdwg::detail::landmark_header& header) { header.landmark_count = header.node_count + 1; }),
+		    reseal([huge](gdwg::detail::landmark_header& header) {
+			    header.node_count = huge;
+			    header.landmark_count = huge;
+		    }),
+		    reseal([](gdwg::detail::landmark_header& header) {
+			    header.node_count = std::numeric_limits<std::uint32_t>::max();
+			    header.landmark_count = std::numeric_limits<std::uint32_t>::max();
+		    }),
+		    reseal([](gdwg::detail::landmark_header& header) { header.node_count *= 1000; }),
+		};
+		for (auto const& edited : edits) {
+			auto in = std::istringstream(edited, std::ios::binary);
+			CHECK_THROWS_MATCHES(gdwg::load_landmarks(in, g),
+			                     std::runtime_error,
+			                     Catch::Matchers::Message("Cannot call gdwg::load_landmarks when the input is "
+			                                              "truncated or its sections are malformed"));
+		}
+	}
+
+	SECTION("Other files and weight types") {
+		auto header = bytes;
+		header[0] = 'X';
+		auto in = std::istringstream(header, std::ios::binary);
+		CHECK_THROWS_MATCHES(gdwg::load_landmarks(in, g),
+		                     std::runtime_error,
+		                     Catch::Matchers::Message("Cannot call gdwg::load_landmarks when the input is not a "
+		                                              "landmark table"));
+		auto other = std::istringstream(bytes, std::ios::binary);
+		auto const doubles = gdwg::graph<int, double>{};
+		CHECK_THROWS_MATCHES(gdwg::load_landmarks(other, doubles),
+		                     std::runtime_error,
+		                     Catch::Matchers::Message("Cannot call gdwg::load_landmarks when the input is not a "
+		                                              "landmark table"));
+	}
+
+	SECTION("Tables for another graph") {
+		// Same node and edge counts, but one edge moved.
+		auto moved = g;
+		moved.erase_edge(moved.begin());
+		moved.insert_edge(0, side + 1, 3);
+		auto in = std::istringstream(bytes, std::ios::binary);
+		CHECK_THROWS_MATCHES(gdwg::load_landmarks(in, moved),
+		                     std::runtime_error,
+		                     Catch::Matchers::Message("Cannot call gdwg::load_landmarks with a landmark table built "
+		                                              "for a different graph"));
+
+		g.insert_edge(0, side + 1, 3);
+		auto ignored = std::ostringstream(std::ios::binary);
+		CHECK_THROWS_MATCHES(gdwg::save_landmarks(table, g, ignored),
+		                     std::runtime_error,
+		                     Catch::Matchers::Message("Cannot call gdwg::save_landmarks with a landmark table built "
+		                                              "for a different graph"));
+		CHECK_THROWS_MATCHES(gdwg::astar(g, 0, 1, table),
+		                     std::runtime_error,
+		                     Catch::Matchers::Message("Cannot call gdwg::astar with a landmark table built for a "
+		                                              "different graph"));
+	}
+
+	SECTION("Bad landmarks and weights") {
+		CHECK_THROWS_MATCHES(gdwg::make_landmark_table(g, std::vector<int>{-1}),
+		                     std::runtime_error,
+		                     Catch::Matchers::Message("Cannot call gdwg::make_landmark_table if a landmark doesn't "
+		                                              "exist in the graph"));
+		g.insert_edge(0, 1, -2);
+		CHECK_THROWS_MATCHES(gdwg::make_landmark_table(g),
+		                     std::runtime_error,
+		                     Catch::Matchers::Message("Cannot call gdwg::make_landmark_table on a graph with negative "
+		                                              "edge weights"));
+	}
+}
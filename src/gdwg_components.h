@@ -0,0 +1,469 @@
+#ifndef GDWG_COMPONENTS_H
+#define GDWG_COMPONENTS_H
+
+#include "gdwg_graph.h"
+#include "gdwg_parallel.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <map>
+#include <optional>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace gdwg {
+	// A partition of a graph's nodes, indexed by the graph's dense node ids.
+	struct component_labels {
+		static constexpr auto unassigned = std::numeric_limits<std::uint32_t>::max();
+
+		// The component of each node, in [0, count()).
+		std::vector<std::uint32_t> labels;
+		// The number of nodes in each component.
+		std::vector<std::size_t> sizes;
+
+		[[nodiscard]] auto count() const noexcept -> std::size_t {
+			return sizes.size();
+		}
+	};
+
+	namespace detail {
+		inline auto count_component_sizes(component_labels& components, std::size_t count) -> void {
+			components.sizes.assign(count, 0);
+			for (auto label : components.labels) {
+				++components.sizes[label];
+			}
+		}
+	} // namespace detail
+
+	// Strongly connected components by an iterative Tarjan search, which keeps its own stack
+	// instead of recursing, so path-like graphs of any length are safe. Components are numbered in
+	// topological order of the condensation: every edge between two components runs from the
+	// lower label to the higher.
+	template<typename N, typename E>
+	auto strongly_connected_components(graph<N, E> const& g) -> component_labels {
+		using node_id = std::uint32_t;
+		constexpr auto unvisited = std::numeric_limits<node_id>::max();
+		auto const n = g.node_count();
+		auto index = std::vector<node_id>(n, unvisited);
+		auto low = std::vector<node_id>(n);
+		auto on_stack = std::vector<bool>(n, false);
+		auto stack = std::vector<node_id>{};
+		// (node, position of the next out-edge to follow)
+		auto calls = std::vector<std::pair<node_id, std::size_t>>{};
+		auto components = component_labels{};
+		components.labels.assign(n, component_labels::unassigned);
+		auto next_index = node_id{0};
+		auto finished = node_id{0};
+
+		auto const enter = [&](node_id v) {
+			index[v] = low[v] = next_index++;
+			stack.push_back(v);
+			on_stack[v] = true;
+			calls.emplace_back(v, 0);
+		};
+		for (auto root = node_id{0}; root < n; ++root) {
+			if (index[root] != unvisited) {
+				continue;
+			}
+			enter(root);
+			while (!calls.empty()) {
+				auto const v = calls.back().first;
+				auto const edges = g.out_edges(v);
+				if (auto& position = calls.back().second; position < edges.size()) {
+					auto const w = edges[position++].dst;
+					if (index[w] == unvisited) {
+						enter(w);
+					}
+					else if (on_stack[w]) {
+						low[v] = std::min(low[v], index[w]);
+					}
+					continue;
+				}
+				if (low[v] == index[v]) {
+					for (auto w = unvisited; w != v;) {
+						w = stack.back();
+						stack.pop_back();
+						on_stack[w] = false;
+						components.labels[w] = finished;
+					}
+					++finished;
+				}
+				calls.pop_back();
+				if (!calls.empty()) {
+					auto const parent = calls.back().first;
+					low[parent] = std::min(low[parent], low[v]);
+				}
+			}
+		}
+		// Tarjan completes sink components first, so reverse the numbering.
+		for (auto& label : components.labels) {
+			label = finished - 1 - label;
+		}
+		detail::count_component_sizes(components, finished);
+		return components;
+	}
+
+	// Strongly connected components on pool's workers. Nodes that cannot be on a cycle are
+	// trimmed first, the component of a high-degree pivot is then found as the intersection of
+	// its forward and backward reachable sets, and the rest is split by colouring: each node
+	// takes the largest id that reaches it, and every node whose colour is its own id collects its
+	// component by a backward search within its colour. Gives the same partition as the
+	// sequential overload, but numbers the components in no particular order.
+	template<typename N, typename E>
+	auto strongly_connected_components(graph<N, E> const& g, worker_pool& pool) -> component_labels {
+		using node_id = std::uint32_t;
+		auto const n = g.node_count();
+		auto components = component_labels{};
+		components.labels.assign(n, component_labels::unassigned);
+		auto& labels = components.labels;
+		auto next_label = std::uint32_t{0};
+		auto active = std::vector<node_id>(n);
+		for (auto v = node_id{0}; v < n; ++v) {
+			active[v] = v;
+		}
+		auto const is_active = [&labels](node_id v) { return labels[v] == component_labels::unassigned; };
+		auto const compact = [&] {
+			active.erase(std::remove_if(active.begin(), active.end(), [&](node_id v) { return !is_active(v); }),
+			             active.end());
+		};
+
+		// Repeatedly removes nodes with no other active predecessor or no other active successor,
+		// which are components of their own. Each node counts its active in- and out-edges, and
+		// removing a node decrements its neighbours' counts, so the whole peel is linear.
+		auto in_counts = std::vector<std::atomic<std::uint32_t>>(n);
+		auto out_counts = std::vector<std::atomic<std::uint32_t>>(n);
+		auto claimed = std::vector<std::atomic<char>>(n);
+		auto peeled = std::vector<std::vector<node_id>>(pool.size());
+		auto const trim = [&] {
+			pool.for_each(active.size(), [&](std::size_t worker, std::size_t i) {
+				auto const v = active[i];
+				auto const sources = g.in_edges(v);
+				auto const edges = g.out_edges(v);
+				auto const in = std::count_if(sources.begin(), sources.end(), [&](node_id u) {
+					return u != v and is_active(u);
+				});
+				auto const out = std::count_if(edges.begin(), edges.end(), [&](auto const& record) {
+					return record.dst != v and is_active(record.dst);
+				});
+				in_counts[v].store(static_cast<std::uint32_t>(in), std::memory_order_relaxed);
+				out_counts[v].store(static_cast<std::uint32_t>(out), std::memory_order_relaxed);
+				claimed[v].store(in == 0 or out == 0 ? 1 : 0, std::memory_order_relaxed);
+				if (in == 0 or out == 0) {
+					peeled[worker].push_back(v);
+				}
+			});
+			auto frontier = std::vector<node_id>{};
+			for (;;) {
+				frontier.clear();
+				for (auto& nodes : peeled) {
+					frontier.insert(frontier.end(), nodes.begin(), nodes.end());
+					nodes.clear();
+				}
+				if (frontier.empty()) {
+					break;
+				}
+				for (auto v : frontier) {
+					labels[v] = next_label++;
+				}
+				pool.for_each(frontier.size(), [&](std::size_t worker, std::size_t i) {
+					auto const v = frontier[i];
+					auto const release = [&](node_id w, std::atomic<std::uint32_t>& count) {
+						if (w != v and is_active(w) and count.fetch_sub(1, std::memory_order_relaxed) == 1
+						    and claimed[w].exchange(1, std::memory_order_relaxed) == 0)
+						{
+							peeled[worker].push_back(w);
+						}
+					};
+					for (auto const& record : g.out_edges(v)) {
+						release(record.dst, in_counts[record.dst]);
+					}
+					for (auto u : g.in_edges(v)) {
+						release(u, out_counts[u]);
+					}
+				});
+			}
+			compact();
+		};
+
+		// Marks every active node reachable from start along edges in the given direction.
+		auto reached = std::vector<std::atomic<char>>(n);
+		auto next_frontiers = std::vector<std::vector<node_id>>(pool.size());
+		auto const reach = [&](node_id start, bool forward) {
+			for (auto v : active) {
+				reached[v].store(0, std::memory_order_relaxed);
+			}
+			reached[start].store(1, std::memory_order_relaxed);
+			auto frontier = std::vector<node_id>{start};
+			while (!frontier.empty()) {
+				pool.for_each_block(frontier.size(), 64, [&](std::size_t worker, std::size_t first, std::size_t last) {
+					auto const visit = [&](node_id w) {
+						if (is_active(w) and reached[w].load(std::memory_order_relaxed) == 0
+						    and reached[w].exchange(1, std::memory_order_relaxed) == 0)
+						{
+							next_frontiers[worker].push_back(w);
+						}
+					};
+					for (auto i = first; i < last; ++i) {
+						if (forward) {
+							for (auto const& record : g.out_edges(frontier[i])) {
+								visit(record.dst);
+							}
+						}
+						else {
+							for (auto u : g.in_edges(frontier[i])) {
+								visit(u);
+							}
+						}
+					}
+				});
+				frontier.clear();
+				for (auto& next : next_frontiers) {
+					frontier.insert(frontier.end(), next.begin(), next.end());
+					next.clear();
+				}
+			}
+		};
+
+		trim();
+		if (!active.empty()) {
+			auto const degree = [&g](node_id v) { return g.in_edges(v).size() * g.out_edges(v).size(); };
+			auto const pivot = *std::max_element(active.begin(), active.end(), [&](node_id a, node_id b) {
+				return degree(a) < degree(b);
+			});
+			reach(pivot, true);
+			auto forward = std::vector<char>(n, 0);
+			for (auto v : active) {
+				forward[v] = reached[v].load(std::memory_order_relaxed);
+			}
+			reach(pivot, false);
+			auto const label = next_label++;
+			for (auto v : active) {
+				if (forward[v] != 0 and reached[v].load(std::memory_order_relaxed) != 0) {
+					labels[v] = label;
+				}
+			}
+			compact();
+			trim();
+		}
+
+		auto colours = std::vector<std::atomic<node_id>>(n);
+		auto roots = std::vector<node_id>{};
+		while (!active.empty()) {
+			for (auto v : active) {
+				colours[v].store(v, std::memory_order_relaxed);
+			}
+			for (auto changed = std::atomic<bool>{true}; changed.exchange(false);) {
+				pool.for_each(active.size(), [&](std::size_t, std::size_t i) {
+					auto const v = active[i];
+					auto const colour = colours[v].load(std::memory_order_relaxed);
+					for (auto const& record : g.out_edges(v)) {
+						if (!is_active(record.dst)) {
+							continue;
+						}
+						auto current = colours[record.dst].load(std::memory_order_relaxed);
+						while (current < colour) {
+							if (colours[record.dst].compare_exchange_weak(current, colour, std::memory_order_relaxed)) {
+								changed.store(true, std::memory_order_relaxed);
+								break;
+							}
+						}
+					}
+				});
+			}
+
+			roots.clear();
+			for (auto v : active) {
+				if (colours[v].load(std::memory_order_relaxed) == v) {
+					roots.push_back(v);
+				}
+			}
+			auto const first_label = next_label;
+			next_label += static_cast<std::uint32_t>(roots.size());
+			// Each root's backward search stays inside its own colour, so no two searches touch the
+			// same node.
+			pool.for_each(
+			    roots.size(),
+			    [&](std::size_t, std::size_t i) {
+				    auto const root = roots[i];
+				    auto const label = first_label + static_cast<std::uint32_t>(i);
+				    auto stack = std::vector<node_id>{root};
+				    labels[root] = label;
+				    while (!stack.empty()) {
+					    auto const v = stack.back();
+					    stack.pop_back();
+					    for (auto u : g.in_edges(v)) {
+						    // The colour check comes first, so labels outside this colour are never read.
+						    if (colours[u].load(std::memory_order_relaxed) == root
+						        and labels[u] == component_labels::unassigned)
+						    {
+							    labels[u] = label;
+							    stack.push_back(u);
+						    }
+					    }
+				    }
+			    },
+			    1);
+			compact();
+			trim();
+		}
+		detail::count_component_sizes(components, next_label);
+		return components;
+	}
+
+	namespace detail {
+		// A union-find forest that many threads can unite into at once without locks. Each node's
+		// entry packs its rank into the high half and its parent into the low half, so a root can be
+		// linked under another with a single compare-and-swap that fails if it stopped being a root
+		// or its rank changed in the meantime.
+		class concurrent_union_find {
+		 public:
+			explicit concurrent_union_find(std::size_t count)
+			: entries_(count) {
+				for (auto v = std::size_t{0}; v < count; ++v) {
+					entries_[v].store(v, std::memory_order_relaxed);
+				}
+			}
+
+			// Finds v's root, halving the path on the way by pointing nodes at their grandparents.
+			auto find(std::uint32_t v) -> std::uint32_t {
+				for (;;) {
+					auto entry = entries_[v].load(std::memory_order_acquire);
+					auto const parent = parent_of(entry);
+					if (parent == v) {
+						return v;
+					}
+					auto const grandparent = parent_of(entries_[parent].load(std::memory_order_acquire));
+					if (grandparent != parent) {
+						entries_[v].compare_exchange_weak(entry, pack(rank_of(entry), grandparent));
+					}
+					v = grandparent;
+				}
+			}
+
+			// Links the roots of a and b, the lower rank under the higher and the higher id under the
+			// lower on a tie.
+			auto unite(std::uint32_t a, std::uint32_t b) -> void {
+				for (;;) {
+					a = find(a);
+					b = find(b);
+					if (a == b) {
+						return;
+					}
+					auto entry_a = entries_[a].load(std::memory_order_acquire);
+					auto entry_b = entries_[b].load(std::memory_order_acquire);
+					if (parent_of(entry_a) != a or parent_of(entry_b) != b) {
+						continue;
+					}
+					if (rank_of(entry_a) < rank_of(entry_b) or (rank_of(entry_a) == rank_of(entry_b) and a > b)) {
+						std::swap(a, b);
+						std::swap(entry_a, entry_b);
+					}
+					// b becomes a child of a.
+					if (!entries_[b].compare_exchange_strong(entry_b, pack(rank_of(entry_b), a))) {
+						continue;
+					}
+					if (rank_of(entry_a) == rank_of(entry_b)) {
+						// Only a hint: if a changed meanwhile, its rank stays as it is.
+						entries_[a].compare_exchange_strong(entry_a, pack(rank_of(entry_a) + 1, a));
+					}
+					return;
+				}
+			}
+
+		 private:
+			static auto pack(std::uint64_t rank, std::uint32_t parent) noexcept -> std::uint64_t {
+				return rank << 32 | parent;
+			}
+
+			static auto parent_of(std::uint64_t entry) noexcept -> std::uint32_t {
+				return static_cast<std::uint32_t>(entry);
+			}
+
+			static auto rank_of(std::uint64_t entry) noexcept -> std::uint64_t {
+				return entry >> 32;
+			}
+
+			std::vector<std::atomic<std::uint64_t>> entries_;
+		};
+	} // namespace detail
+
+	// Weakly connected components: the components of g with edge directions ignored. pool's
+	// workers unite the ends of every edge in a lock-free union-find, then each node looks up its
+	// root. Components are numbered in order of their smallest node id.
+	template<typename N, typename E>
+	auto weakly_connected_components(graph<N, E> const& g, worker_pool& pool) -> component_labels {
+		using node_id = std::uint32_t;
+		auto const n = g.node_count();
+		auto forest = detail::concurrent_union_find(n);
+		pool.for_each(n, [&](std::size_t, std::size_t i) {
+			auto const u = static_cast<node_id>(i);
+			for (auto const& record : g.out_edges(u)) {
+				forest.unite(u, record.dst);
+			}
+		});
+		auto roots = std::vector<node_id>(n);
+		pool.for_each(n, [&](std::size_t, std::size_t i) { roots[i] = forest.find(static_cast<node_id>(i)); });
+
+		auto components = component_labels{};
+		components.labels.assign(n, component_labels::unassigned);
+		auto root_labels = std::vector<std::uint32_t>(n, component_labels::unassigned);
+		auto next_label = std::uint32_t{0};
+		for (auto v = node_id{0}; v < n; ++v) {
+			auto& label = root_labels[roots[v]];
+			if (label == component_labels::unassigned) {
+				label = next_label++;
+			}
+			components.labels[v] = label;
+		}
+		detail::count_component_sizes(components, next_label);
+		return components;
+	}
+
+	template<typename N, typename E>
+	auto weakly_connected_components(graph<N, E> const& g, std::size_t threads = 0) -> component_labels {
+		auto pool = worker_pool(threads);
+		return weakly_connected_components(g, pool);
+	}
+
+	// The component of every node keyed by its value, for callers that work in node values rather
+	// than dense ids.
+	template<typename N, typename E>
+	auto component_map(graph<N, E> const& g, component_labels const& components) -> std::map<N, std::uint32_t> {
+		auto result = std::map<N, std::uint32_t>{};
+		for (auto v = std::uint32_t{0}; v < g.node_count(); ++v) {
+			result.emplace(g.node(v), components.labels[v]);
+		}
+		return result;
+	}
+
+	// The condensation of g under components: one node per component, labelled by its component
+	// id, and every edge of g between two different components, keeping its weight. Edges that
+	// map to the same pair of components with the same weight merge, as they would in any graph.
+	template<typename N, typename E>
+	auto condensation(graph<N, E> const& g, component_labels const& components) -> graph<std::uint32_t, E> {
+		auto dag = graph<std::uint32_t, E>{};
+		auto ids = std::vector<std::uint32_t>(components.count());
+		for (auto i = std::size_t{0}; i < ids.size(); ++i) {
+			ids[i] = static_cast<std::uint32_t>(i);
+		}
+		dag.insert_nodes(ids);
+		auto batch = std::vector<std::tuple<std::uint32_t, std::uint32_t, std::optional<E>>>{};
+		for (auto u = std::uint32_t{0}; u < g.node_count(); ++u) {
+			for (auto const& record : g.out_edges(u)) {
+				auto const from = components.labels[u];
+				auto const to = components.labels[record.dst];
+				if (from != to) {
+					batch.emplace_back(from, to, record.weight);
+				}
+			}
+		}
+		dag.insert_edges(batch);
+		return dag;
+	}
+} // namespace gdwg
+
+#endif // GDWG_COMPONENTS_H
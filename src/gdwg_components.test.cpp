@@ -0,0 +1,200 @@
+#include "gdwg_components.h"
+
+#include <catch2/catch.hpp>
+
+#include <map>
+#include <optional>
+#include <random>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace {
+	auto random_graph(unsigned seed, int nodes, int edges) -> gdwg::graph<int, int> {
+		auto engine = std::mt19937(seed);
+		auto node = std::uniform_int_distribution<int>(0, nodes - 1);
+		auto g = gdwg::graph<int, int>{};
+		for (auto i = 0; i < nodes; ++i) {
+			g.insert_node(i);
+		}
+		auto batch = std::vector<std::tuple<int, int, std::optional<int>>>{};
+		for (auto i = 0; i < edges; ++i) {
+			batch.emplace_back(node(engine), node(engine), i % 3);
+		}
+		g.insert_edges(batch);
+		return g;
+	}
+
+	// Two labellings describe the same partition if they map onto each other one to one.
+	auto same_partition(gdwg::component_labels const& a, gdwg::component_labels const& b) -> bool {
+		if (a.labels.size() != b.labels.size() or a.count() != b.count()) {
+			return false;
+		}
+		auto forward = std::map<std::uint32_t, std::uint32_t>{};
+		auto backward = std::map<std::uint32_t, std::uint32_t>{};
+		for (auto i = std::size_t{0}; i < a.labels.size(); ++i) {
+			auto [f, f_new] = forward.emplace(a.labels[i], b.labels[i]);
+			auto [r, r_new] = backward.emplace(b.labels[i], a.labels[i]);
+			if (f->second != b.labels[i] or r->second != a.labels[i]) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	auto check_sizes(gdwg::component_labels const& components) -> void {
+		auto sizes = std::vector<std::size_t>(components.count());
+		for (auto label : components.labels) {
+			REQUIRE(label < components.count());
+			++sizes[label];
+		}
+		CHECK(sizes == components.sizes);
+	}
+} // namespace
+
+TEST_CASE("Strongly Connected Components - Small Graph") {
+	auto g = gdwg::graph<std::string, int>{"a", "b", "c", "d", "e", "f"};
+	g.insert_edge("a", "b", 1);
+	g.insert_edge("b", "c");
+	g.insert_edge("c", "a", 2);
+	g.insert_edge("c", "d", 3);
+	g.insert_edge("d", "e");
+	g.insert_edge("e", "d", 4);
+	g.insert_edge("f", "f");
+
+	auto const components = gdwg::strongly_connected_components(g);
+	auto const label = [&](char const* value) { return components.labels[*g.id_of(value)]; };
+	CHECK(components.count() == 3);
+	CHECK(label("a") == label("b"));
+	CHECK(label("b") == label("c"));
+	CHECK(label("d") == label("e"));
+	CHECK(label("a") < label("d"));
+	check_sizes(components);
+
+	auto pool = gdwg::worker_pool(2);
+	CHECK(same_partition(gdwg::strongly_connected_components(g, pool), components));
+
+	auto const dag = gdwg::condensation(g, components);
+	CHECK(dag.node_count() == 3);
+	CHECK(dag.edge_count() == 1);
+	CHECK(dag.find(label("a"), label("d"), 3) != dag.end());
+}
+
+TEST_CASE("Strongly Connected Components - Topological Labels") {
+	auto const g = random_graph(2, 3000, 3600);
+	auto const components = gdwg::strongly_connected_components(g);
+	check_sizes(components);
+	for (auto const& [from, to, weight] : g) {
+		CHECK(components.labels[*g.id_of(from)] <= components.labels[*g.id_of(to)]);
+	}
+	auto const dag = gdwg::condensation(g, components);
+	CHECK(gdwg::strongly_connected_components(dag).count() == dag.node_count());
+}
+
+TEST_CASE("Strongly Connected Components - Parallel Matches Tarjan") {
+	auto const threads = GENERATE(std::size_t{1}, std::size_t{4});
+	auto const edges = GENERATE(1000, 2500, 6000, 20000);
+	auto pool = gdwg::worker_pool(threads);
+	auto const g = random_graph(static_cast<unsigned>(edges), 2000, edges);
+	auto const expected = gdwg::strongly_connected_components(g);
+	auto const components = gdwg::strongly_connected_components(g, pool);
+	CHECK(same_partition(components, expected));
+	check_sizes(components);
+}
+
+TEST_CASE("Strongly Connected Components - Long Paths Do Not Recurse") {
+	constexpr auto length = 200000;
+	auto g = gdwg::graph<int, int>{};
+	auto nodes = std::vector<int>(length);
+	auto batch = std::vector<std::tuple<int, int, std::optional<int>>>{};
+	for (auto i = 0; i < length; ++i) {
+		nodes[static_cast<std::size_t>(i)] = i;
+		batch.emplace_back(i, (i + 1) % length, std::nullopt);
+	}
+	g.insert_nodes(nodes);
+	g.insert_edges(batch);
+	CHECK(gdwg::strongly_connected_components(g).count() == 1);
+
+	g.erase_edge(length - 1, 0);
+	auto const components = gdwg::strongly_connected_components(g);
+	CHECK(components.count() == length);
+	CHECK(components.labels[*g.id_of(0)] == 0);
+	auto pool = gdwg::worker_pool(2);
+	CHECK(gdwg::strongly_connected_components(g, pool).count() == length);
+}
+
+TEST_CASE("Weakly Connected Components - Small Graph") {
+	auto g = gdwg::graph<std::string, int>{"a", "b", "c", "d", "e", "f"};
+	g.insert_edge("a", "b", 1);
+	g.insert_edge("c", "b", 2);
+	g.insert_edge("e", "d", 3);
+	g.insert_edge("f", "f", 4);
+	auto const components = gdwg::weakly_connected_components(g, 1);
+	REQUIRE(components.count() == 3);
+	check_sizes(components);
+	auto const by_node = gdwg::component_map(g, components);
+	CHECK(by_node == std::map<std::string, std::uint32_t>{{"a", 0}, {"b", 0}, {"c", 0}, {"d", 1}, {"e", 1}, {"f", 2}});
+	CHECK(components.sizes == std::vector<std::size_t>{3, 2, 1});
+}
+
+TEST_CASE("Weakly Connected Components - Parallel Matches A Search") {
+	auto const threads = GENERATE(std::size_t{1}, std::size_t{4});
+	auto const edges = GENERATE(500, 1500, 4000);
+	auto pool = gdwg::worker_pool(threads);
+	auto const g = random_graph(static_cast<unsigned>(edges) + 1, 2000, edges);
+
+	// Reference labels by an undirected depth-first search.
+	auto expected = gdwg::component_labels{};
+	expected.labels.assign(g.node_count(), gdwg::component_labels::unassigned);
+	auto count = std::uint32_t{0};
+	for (auto root = std::uint32_t{0}; root < g.node_count(); ++root) {
+		if (expected.labels[root] != gdwg::component_labels::unassigned) {
+			continue;
+		}
+		auto stack = std::vector<std::uint32_t>{root};
+		expected.labels[root] = count;
+		while (!stack.empty()) {
+			auto const v = stack.back();
+			stack.pop_back();
+			auto neighbours = std::vector<std::uint32_t>(g.in_edges(v).begin(), g.in_edges(v).end());
+			for (auto const& record : g.out_edges(v)) {
+				neighbours.push_back(record.dst);
+			}
+			for (auto w : neighbours) {
+				if (expected.labels[w] == gdwg::component_labels::unassigned) {
+					expected.labels[w] = count;
+					stack.push_back(w);
+				}
+			}
+		}
+		++count;
+	}
+	expected.sizes.assign(count, 0);
+	for (auto label : expected.labels) {
+		++expected.sizes[label];
+	}
+
+	auto const components = gdwg::weakly_connected_components(g, pool);
+	// Both number components by their smallest node id.
+	CHECK(components.labels == expected.labels);
+	check_sizes(components);
+}
+
+TEST_CASE("Weakly Connected Components - Long Paths") {
+	constexpr auto length = 200000;
+	auto g = gdwg::graph<int, int>{};
+	auto nodes = std::vector<int>(length);
+	auto batch = std::vector<std::tuple<int, int, std::optional<int>>>{};
+	for (auto i = 0; i < length; ++i) {
+		nodes[static_cast<std::size_t>(i)] = i;
+		if (i % 1000 != 999) {
+			batch.emplace_back(length - 1 - i, length - 2 - i, std::nullopt);
+		}
+	}
+	g.insert_nodes(nodes);
+	g.insert_edges(batch);
+	auto const components = gdwg::weakly_connected_components(g, 4);
+	CHECK(components.count() == length / 1000);
+	check_sizes(components);
+	CHECK(components.sizes == std::vector<std::size_t>(length / 1000, 1000));
+}
@@ -0,0 +1 @@
+#include "gdwg_csr_graph.h"
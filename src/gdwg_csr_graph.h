@@ -0,0 +1,268 @@
+#ifndef GDWG_CSR_GRAPH_H
+#define GDWG_CSR_GRAPH_H
+
+#include "gdwg_graph.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace gdwg {
+	// An immutable compressed-sparse-row freeze of a gdwg::graph. Nodes are stored once in a sorted
+	// table and referred to everywhere else by their dense index into it, and the edges of node i
+	// occupy [offsets()[i], offsets()[i + 1]) of the destination and weight arrays, in the same
+	// (dst, unweighted first, weight) order that gdwg::graph iterates them.
+	template<typename N, typename E>
+	class csr_graph {
+	 public:
+		class iterator;
+		using node_id = std::uint32_t;
+
+		// Constructors and Destructors
+		csr_graph() = default;
+		~csr_graph() = default;
+
+		explicit csr_graph(graph<N, E> const& g)
+		: nodes_(g.nodes())
+		, offsets_(nodes_.size() + 1, 0) {
+			if (nodes_.size() > max_nodes) {
+				throw std::length_error("Cannot construct gdwg::csr_graph<N, E> with more nodes than node_id can "
+				                        "index");
+			}
+			// gdwg::graph iterates edges grouped by ascending source, so each row is filled in turn.
+			auto row = std::size_t{0};
+			for (auto const& [from, to, weight] : g) {
+				while (nodes_[row] < from) {
+					offsets_[++row] = destinations_.size();
+				}
+				destinations_.push_back(*id_of(to));
+				weights_.push_back(weight);
+			}
+			while (row < nodes_.size()) {
+				offsets_[++row] = destinations_.size();
+			}
+		}
+
+		csr_graph(csr_graph&& other) noexcept = default;
+		auto operator=(csr_graph&& other) noexcept -> csr_graph& = default;
+		csr_graph(csr_graph const& other) = default;
+		auto operator=(csr_graph const& other) -> csr_graph& = default;
+
+		// Conversion
+		[[nodiscard]] auto to_graph() const -> graph<N, E> {
+			auto g = graph<N, E>(nodes_.begin(), nodes_.end());
+			for (auto const& [from, to, weight] : *this) {
+				g.insert_edge(from, to, weight);
+			}
+			return g;
+		}
+
+		// Accessors
+		[[nodiscard]] auto is_node(N const& value) const -> bool {
+			return std::binary_search(nodes_.begin(), nodes_.end(), value);
+		}
+
+		[[nodiscard]] auto empty() const noexcept -> bool {
+			return nodes_.empty();
+		}
+
+		[[nodiscard]] auto is_connected(N const& src, N const& dst) const -> bool {
+			auto src_id = id_of(src);
+			auto dst_id = id_of(dst);
+			if (!src_id or !dst_id) {
+				throw std::runtime_error("Cannot call gdwg::csr_graph<N, E>::is_connected if src or dst node don't "
+				                         "exist in the graph");
+			}
+			auto row = out_destinations(*src_id);
+			return std::binary_search(row.begin(), row.end(), *dst_id);
+		}
+
+		[[nodiscard]] auto nodes() const -> std::vector<N> {
+			return nodes_;
+		}
+
+		[[nodiscard]] auto find(N const& src, N const& dst, std::optional<E> const& weight = std::nullopt) const
+		    -> iterator {
+			auto src_id = id_of(src);
+			auto dst_id = id_of(dst);
+			if (!src_id or !dst_id) {
+				return end();
+			}
+			auto row = out_destinations(*src_id);
+			auto [first, last] = std::equal_range(row.begin(), row.end(), *dst_id);
+			auto lo = offsets_[*src_id] + static_cast<std::size_t>(first - row.begin());
+			auto hi = offsets_[*src_id] + static_cast<std::size_t>(last - row.begin());
+			auto weight_first = weights_.begin() + static_cast<std::ptrdiff_t>(lo);
+			auto weight_last = weights_.begin() + static_cast<std::ptrdiff_t>(hi);
+			auto weight_it = std::lower_bound(weight_first, weight_last, weight);
+			if (weight_it == weight_last or *weight_it != weight) {
+				return end();
+			}
+			return iterator(this, *src_id, static_cast<std::size_t>(weight_it - weights_.begin()));
+		}
+
+		[[nodiscard]] auto connections(N const& src) const -> std::vector<N> {
+			auto src_id = id_of(src);
+			if (!src_id) {
+				throw std::runtime_error("Cannot call gdwg::csr_graph<N, E>::connections if src doesn't exist in the "
+				                         "graph");
+			}
+			auto connections = std::vector<N>{};
+			auto row = out_destinations(*src_id);
+			for (auto it = row.begin(); it != row.end(); ++it) {
+				if (it == row.begin() or *std::prev(it) != *it) {
+					connections.push_back(nodes_[*it]);
+				}
+			}
+			return connections;
+		}
+
+		// Dense Access
+		[[nodiscard]] auto node_count() const noexcept -> std::size_t {
+			return nodes_.size();
+		}
+
+		[[nodiscard]] auto edge_count() const noexcept -> std::size_t {
+			return destinations_.size();
+		}
+
+		[[nodiscard]] auto id_of(N const& value) const -> std::optional<node_id> {
+			auto it = std::lower_bound(nodes_.begin(), nodes_.end(), value);
+			if (it == nodes_.end() or *it != value) {
+				return std::nullopt;
+			}
+			return static_cast<node_id>(it - nodes_.begin());
+		}
+
+		[[nodiscard]] auto node(node_id id) const -> N const& {
+			return nodes_[id];
+		}
+
+		[[nodiscard]] auto offsets() const noexcept -> std::span<std::size_t const> {
+			return offsets_;
+		}
+
+		[[nodiscard]] auto destinations() const noexcept -> std::span<node_id const> {
+			return destinations_;
+		}
+
+		[[nodiscard]] auto weights() const noexcept -> std::span<std::optional<E> const> {
+			return weights_;
+		}
+
+		[[nodiscard]] auto out_destinations(node_id id) const -> std::span<node_id const> {
+			return std::span<node_id const>(destinations_).subspan(offsets_[id], offsets_[id + 1] - offsets_[id]);
+		}
+
+		[[nodiscard]] auto out_weights(node_id id) const -> std::span<std::optional<E> const> {
+			return std::span<std::optional<E> const>(weights_).subspan(offsets_[id], offsets_[id + 1] - offsets_[id]);
+		}
+
+		// Iterator Access
+		[[nodiscard]] auto begin() const -> iterator {
+			return iterator(this, 0, 0);
+		}
+
+		[[nodiscard]] auto end() const -> iterator {
+			return iterator(this, nodes_.size(), destinations_.size());
+		}
+
+		// Comparisons
+		[[nodiscard]] auto operator==(csr_graph const& other) const -> bool = default;
+
+		class iterator {
+		 public:
+			using value_type = struct {
+				N from;
+				N to;
+				std::optional<E> weight;
+			};
+			using reference = value_type;
+			using pointer = void;
+			using difference_type = std::ptrdiff_t;
+			using iterator_category = std::bidirectional_iterator_tag;
+
+			// Constructors and Destructors
+			iterator() = default;
+			~iterator() = default;
+
+			// Iterator Source
+			auto operator*() const -> reference {
+				return {graph_->nodes_[row_], graph_->nodes_[graph_->destinations_[index_]], graph_->weights_[index_]};
+			}
+
+			// Iterator Traversal (Pre Increment)
+			auto operator++() -> iterator& {
+				++index_;
+				skip_finished_rows();
+				return *this;
+			}
+
+			// Post Increment
+			auto operator++(int) -> iterator {
+				auto temp = *this;
+				++*this;
+				return temp;
+			}
+
+			// Pre Decrement
+			auto operator--() -> iterator& {
+				--index_;
+				while (graph_->offsets_[row_] > index_) {
+					--row_;
+				}
+				return *this;
+			}
+
+			// Post Decrement
+			auto operator--(int) -> iterator {
+				auto temp = *this;
+				--*this;
+				return temp;
+			}
+
+			// Iterator Comparisons
+			auto operator==(iterator const& other) const noexcept -> bool {
+				return index_ == other.index_;
+			}
+
+		 private:
+			friend class csr_graph;
+
+			explicit iterator(csr_graph const* graph, std::size_t row, std::size_t index)
+			: graph_{graph}
+			, row_{row}
+			, index_{index} {
+				skip_finished_rows();
+			}
+
+			// Moves row_ forward past every row whose edges all precede index_, including empty rows.
+			auto skip_finished_rows() -> void {
+				while (row_ < graph_->nodes_.size() and graph_->offsets_[row_ + 1] <= index_) {
+					++row_;
+				}
+			}
+
+			csr_graph const* graph_ = nullptr;
+			std::size_t row_ = 0;
+			std::size_t index_ = 0;
+		};
+
+	 private:
+		static constexpr auto max_nodes = std::size_t{std::numeric_limits<node_id>::max()};
+
+		std::vector<N> nodes_;
+		std::vector<std::size_t> offsets_ = std::vector<std::size_t>(1, 0);
+		std::vector<node_id> destinations_;
+		std::vector<std::optional<E>> weights_;
+	};
+} // namespace gdwg
+
+#endif // GDWG_CSR_GRAPH_H
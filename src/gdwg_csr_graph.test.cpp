@@ -0,0 +1,140 @@
+#include "gdwg_csr_graph.h"
+
+#include <catch2/catch.hpp>
+
+#include <string>
+#include <vector>
+
+namespace {
+	auto make_graph() -> gdwg::graph<int, int> {
+		auto g = gdwg::graph<int, int>{1, 2, 3, 4, 5, 64};
+		CHECK(g.insert_edge(4, 1, -4));
+		CHECK(g.insert_edge(3, 2, 2));
+		CHECK(g.insert_edge(2, 4));
+		CHECK(g.insert_edge(2, 4, 2));
+		CHECK(g.insert_edge(2, 1, 1));
+		CHECK(g.insert_edge(4, 1));
+		CHECK(g.insert_edge(1, 5, -1));
+		CHECK(g.insert_edge(4, 5, 3));
+		CHECK(g.insert_edge(5, 2));
+		return g;
+	}
+} // namespace
+
+TEST_CASE("CSR Graph Constructors - Default") {
+	auto csr = gdwg::csr_graph<int, int>{};
+	CHECK(csr.empty());
+	CHECK(csr.node_count() == 0);
+	CHECK(csr.edge_count() == 0);
+	CHECK(csr.begin() == csr.end());
+	CHECK(csr.to_graph() == gdwg::graph<int, int>{});
+}
+
+TEST_CASE("CSR Graph Constructors - From Graph") {
+	auto const g = make_graph();
+	auto const csr = gdwg::csr_graph<int, int>(g);
+	CHECK(csr.node_count() == 6);
+	CHECK(csr.edge_count() == 9);
+	CHECK(csr.nodes() == g.nodes());
+	CHECK(csr.offsets().size() == 7);
+	CHECK(csr.offsets().back() == csr.edge_count());
+}
+
+TEST_CASE("CSR Graph Conversion - Round Trip") {
+	auto const g = make_graph();
+	CHECK(gdwg::csr_graph<int, int>(g).to_graph() == g);
+
+	auto s = gdwg::graph<std::string, double>{"a", "b", "c"};
+	CHECK(s.insert_edge("c", "a", 0.5));
+	CHECK(s.insert_edge("a", "a"));
+	CHECK(gdwg::csr_graph<std::string, double>(s).to_graph() == s);
+}
+
+TEST_CASE("CSR Graph Accessor - Is Node") {
+	auto const csr = gdwg::csr_graph<int, int>(make_graph());
+	CHECK(csr.is_node(1));
+	CHECK(csr.is_node(64));
+	REQUIRE_FALSE(csr.is_node(6));
+}
+
+TEST_CASE("CSR Graph Accessor - Is Connected") {
+	auto const csr = gdwg::csr_graph<int, int>(make_graph());
+	CHECK(csr.is_connected(2, 4));
+	CHECK(csr.is_connected(4, 1));
+	REQUIRE_FALSE(csr.is_connected(1, 2));
+	REQUIRE_FALSE(csr.is_connected(64, 1));
+	REQUIRE_THROWS_WITH(csr.is_connected(1, 6),
+	                    "Cannot call gdwg::csr_graph<N, E>::is_connected if src or dst node don't exist in the graph");
+}
+
+TEST_CASE("CSR Graph Accessor - Connections") {
+	auto const csr = gdwg::csr_graph<int, int>(make_graph());
+	CHECK(csr.connections(2) == std::vector<int>{1, 4});
+	CHECK(csr.connections(4) == std::vector<int>{1, 5});
+	CHECK(csr.connections(64).empty());
+	REQUIRE_THROWS_WITH(csr.connections(6),
+	                    "Cannot call gdwg::csr_graph<N, E>::connections if src doesn't exist in the graph");
+}
+
+TEST_CASE("CSR Graph Accessor - Find") {
+	auto const csr = gdwg::csr_graph<int, int>(make_graph());
+	auto it = csr.find(2, 4, 2);
+	REQUIRE(it != csr.end());
+	CHECK((*it).from == 2);
+	CHECK((*it).to == 4);
+	CHECK((*it).weight == 2);
+
+	it = csr.find(4, 1);
+	REQUIRE(it != csr.end());
+	CHECK((*it).weight == std::nullopt);
+
+	CHECK(csr.find(2, 4, 3) == csr.end());
+	CHECK(csr.find(1, 5) == csr.end());
+	CHECK(csr.find(7, 5) == csr.end());
+}
+
+TEST_CASE("CSR Graph Iterator - Matches Graph") {
+	auto const g = make_graph();
+	auto const csr = gdwg::csr_graph<int, int>(g);
+	auto git = g.begin();
+	for (auto const& [from, to, weight] : csr) {
+		REQUIRE(git != g.end());
+		CHECK(from == (*git).from);
+		CHECK(to == (*git).to);
+		CHECK(weight == (*git).weight);
+		++git;
+	}
+	CHECK(git == g.end());
+}
+
+TEST_CASE("CSR Graph Iterator - Decrement") {
+	auto const csr = gdwg::csr_graph<int, int>(make_graph());
+	auto it = csr.end();
+	--it;
+	CHECK((*it).from == 5);
+	CHECK((*it).to == 2);
+	it--;
+	CHECK((*it).from == 4);
+	CHECK((*it).to == 5);
+	CHECK((*it).weight == 3);
+	++it;
+	CHECK(++it == csr.end());
+}
+
+TEST_CASE("CSR Graph Dense Access") {
+	auto const csr = gdwg::csr_graph<int, int>(make_graph());
+	auto two = csr.id_of(2);
+	REQUIRE(two.has_value());
+	CHECK(csr.node(*two) == 2);
+	CHECK(csr.id_of(6) == std::nullopt);
+
+	auto dsts = csr.out_destinations(*two);
+	auto weights = csr.out_weights(*two);
+	REQUIRE(dsts.size() == 3);
+	CHECK(csr.node(dsts[0]) == 1);
+	CHECK(weights[0] == 1);
+	CHECK(csr.node(dsts[1]) == 4);
+	CHECK(weights[1] == std::nullopt);
+	CHECK(csr.node(dsts[2]) == 4);
+	CHECK(weights[2] == 2);
+}
@@ -0,0 +1,161 @@
+#ifndef GDWG_DAG_H
+#define GDWG_DAG_H
+
+#include "gdwg_graph.h"
+#include "gdwg_shortest_paths.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace gdwg {
+	// A topological order of the graph's dense node ids, or a cycle showing there is none.
+	struct topological_order {
+		// Every node, each before all of its successors. Only the nodes that could be ordered if
+		// the graph has a cycle.
+		std::vector<std::uint32_t> order;
+		// The nodes of one directed cycle in edge order, each with an edge to the next and the last
+		// with an edge back to the first. Empty if the graph is acyclic.
+		std::vector<std::uint32_t> cycle;
+
+		[[nodiscard]] auto is_dag() const noexcept -> bool {
+			return cycle.empty();
+		}
+	};
+
+	// Kahn's algorithm over in-degrees taken from the graph's in-edge lists, in O(V + E). The ready
+	// queue is first in, first out: nodes with no in-edges come first in ascending id order, and
+	// every later node follows in the order its last in-edge was removed.
+	template<typename N, typename E>
+	auto topological_sort(graph<N, E> const& g) -> topological_order {
+		using node_id = std::uint32_t;
+		auto const n = g.node_count();
+		auto result = topological_order{};
+		auto& order = result.order;
+		order.reserve(n);
+		auto in_degree = std::vector<std::size_t>(n);
+		for (auto v = node_id{0}; v < n; ++v) {
+			in_degree[v] = g.in_edges(v).size();
+			if (in_degree[v] == 0) {
+				order.push_back(v);
+			}
+		}
+		// order doubles as the queue: [head, order.size()) are ready but not yet expanded.
+		for (auto head = std::size_t{0}; head < order.size(); ++head) {
+			for (auto const& record : g.out_edges(order[head])) {
+				if (--in_degree[record.dst] == 0) {
+					order.push_back(record.dst);
+				}
+			}
+		}
+		if (order.size() == n) {
+			return result;
+		}
+
+		// Every node left has an unordered predecessor, so walking predecessors must revisit a node.
+		constexpr auto unvisited = std::numeric_limits<std::size_t>::max();
+		auto step = std::vector<std::size_t>(n, unvisited);
+		auto walk = std::vector<node_id>{};
+		auto v = node_id{0};
+		while (in_degree[v] == 0) {
+			++v;
+		}
+		while (step[v] == unvisited) {
+			step[v] = walk.size();
+			walk.push_back(v);
+			auto const sources = g.in_edges(v);
+			v = *std::find_if(sources.begin(), sources.end(), [&](node_id u) { return in_degree[u] != 0; });
+		}
+		result.cycle.assign(walk.begin() + static_cast<std::ptrdiff_t>(step[v]), walk.end());
+		// The walk followed edges backwards.
+		std::reverse(result.cycle.begin(), result.cycle.end());
+		return result;
+	}
+
+	namespace detail {
+		// Relaxes every edge once in topological order, keeping a distance whenever better(candidate,
+		// current) holds. Sources start at zero and every other node at infinite_distance.
+		template<typename N, typename E, typename Better>
+		auto dag_paths(graph<N, E> const& g,
+		               std::vector<std::uint32_t> const& sources,
+		               E const& unweighted_cost,
+		               char const* function,
+		               Better better) -> shortest_path_tree<E> {
+			auto const sorted = topological_sort(g);
+			if (!sorted.is_dag()) {
+				throw std::runtime_error(std::string("Cannot call ") + function + " on a graph with a cycle");
+			}
+			auto tree = shortest_path_tree<E>{};
+			tree.source = sources.size() == 1 ? sources.front() : shortest_path_tree<E>::no_node;
+			tree.distances.assign(g.node_count(), infinite_distance<E>);
+			tree.predecessors.assign(g.node_count(), shortest_path_tree<E>::no_node);
+			for (auto source : sources) {
+				tree.distances[source] = E{0};
+			}
+			for (auto u : sorted.order) {
+				if (tree.distances[u] == infinite_distance<E>) {
+					continue;
+				}
+				++tree.settled;
+				for (auto const& record : g.out_edges(u)) {
+					auto const candidate = tree.distances[u] + edge_cost(record, unweighted_cost);
+					auto& current = tree.distances[record.dst];
+					if (current == infinite_distance<E> or better(candidate, current)) {
+						current = candidate;
+						tree.predecessors[record.dst] = u;
+					}
+				}
+			}
+			return tree;
+		}
+	} // namespace detail
+
+	// Shortest paths from source in a DAG in one pass over a topological order. Negative weights
+	// are allowed. Unweighted edges cost unweighted_cost. Throws std::runtime_error if g has a
+	// cycle or source is not a node.
+	template<typename N, typename E>
+	requires std::is_arithmetic_v<E>
+	auto dag_shortest_paths(graph<N, E> const& g,
+	                        std::type_identity_t<N> const& source,
+	                        std::type_identity_t<E> const& unweighted_cost = E{1}) -> shortest_path_tree<E> {
+		auto const src =
+		    detail::id_or_throw(g, source, "Cannot call gdwg::dag_shortest_paths if source doesn't exist in the graph");
+		return detail::dag_paths(g, {src}, unweighted_cost, "gdwg::dag_shortest_paths", std::less<>{});
+	}
+
+	// Longest paths from source in a DAG, as dag_shortest_paths.
+	template<typename N, typename E>
+	requires std::is_arithmetic_v<E>
+	auto dag_longest_paths(graph<N, E> const& g,
+	                       std::type_identity_t<N> const& source,
+	                       std::type_identity_t<E> const& unweighted_cost = E{1}) -> shortest_path_tree<E> {
+		auto const src =
+		    detail::id_or_throw(g, source, "Cannot call gdwg::dag_longest_paths if source doesn't exist in the graph");
+		return detail::dag_paths(g, {src}, unweighted_cost, "gdwg::dag_longest_paths", std::greater<>{});
+	}
+
+	// The critical path of a DAG: a heaviest path starting anywhere, as node ids from first to last.
+	template<typename N, typename E>
+	requires std::is_arithmetic_v<E>
+	auto critical_path(graph<N, E> const& g, std::type_identity_t<E> const& unweighted_cost = E{1})
+	    -> std::vector<std::uint32_t> {
+		if (g.node_count() == 0) {
+			return {};
+		}
+		auto sources = std::vector<std::uint32_t>(g.node_count());
+		for (auto v = std::uint32_t{0}; v < g.node_count(); ++v) {
+			sources[v] = v;
+		}
+		auto const tree = detail::dag_paths(g, sources, unweighted_cost, "gdwg::critical_path", std::greater<>{});
+		auto const last = std::max_element(tree.distances.begin(), tree.distances.end()) - tree.distances.begin();
+		return tree.path_to(static_cast<std::uint32_t>(last));
+	}
+} // namespace gdwg
+
+#endif // GDWG_DAG_H
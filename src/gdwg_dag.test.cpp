@@ -0,0 +1,126 @@
+#include "gdwg_dag.h"
+
+#include <catch2/catch.hpp>
+
+#include <optional>
+#include <random>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace {
+	// A build graph: each edge means the source must finish before the destination starts, and
+	// weighs the source's duration.
+	auto make_build() -> gdwg::graph<std::string, int> {
+		auto g = gdwg::graph<std::string, int>{"fetch", "configure", "compile", "test", "docs", "package"};
+		g.insert_edge("fetch", "configure", 2);
+		g.insert_edge("configure", "compile", 3);
+		g.insert_edge("configure", "docs", 3);
+		g.insert_edge("compile", "test", 10);
+		g.insert_edge("compile", "package", 10);
+		g.insert_edge("test", "package", 4);
+		g.insert_edge("docs", "package");
+		return g;
+	}
+
+	auto names(gdwg::graph<std::string, int> const& g, std::vector<std::uint32_t> const& ids)
+	    -> std::vector<std::string> {
+		auto result = std::vector<std::string>{};
+		for (auto id : ids) {
+			result.push_back(g.node(id));
+		}
+		return result;
+	}
+} // namespace
+
+TEST_CASE("Topological Sort - Orders Every Edge") {
+	auto const g = make_build();
+	auto const sorted = gdwg::topological_sort(g);
+	REQUIRE(sorted.is_dag());
+	REQUIRE(sorted.order.size() == g.node_count());
+	auto position = std::vector<std::size_t>(g.node_count());
+	for (auto i = std::size_t{0}; i < sorted.order.size(); ++i) {
+		position[sorted.order[i]] = i;
+	}
+	for (auto const& [from, to, weight] : g) {
+		CHECK(position[*g.id_of(from)] < position[*g.id_of(to)]);
+	}
+	CHECK(g.node(sorted.order.front()) == "fetch");
+	CHECK(g.node(sorted.order.back()) == "package");
+}
+
+TEST_CASE("Topological Sort - Reports A Cycle") {
+	auto g = make_build();
+	g.insert_edge("package", "configure", 1);
+	auto const sorted = gdwg::topological_sort(g);
+	CHECK(!sorted.is_dag());
+	CHECK(sorted.order.size() < g.node_count());
+	REQUIRE(!sorted.cycle.empty());
+	for (auto i = std::size_t{0}; i < sorted.cycle.size(); ++i) {
+		auto const next = sorted.cycle[(i + 1) % sorted.cycle.size()];
+		CHECK(g.is_connected(g.node(sorted.cycle[i]), g.node(next)));
+	}
+
+	CHECK_THROWS_MATCHES(gdwg::dag_shortest_paths(g, "fetch"),
+	                     std::runtime_error,
+	                     Catch::Matchers::Message("Cannot call gdwg::dag_shortest_paths on a graph with a cycle"));
+
+	auto loop = gdwg::graph<int, int>{1, 2};
+	loop.insert_edge(2, 2);
+	CHECK(gdwg::topological_sort(loop).cycle == std::vector<std::uint32_t>{*loop.id_of(2)});
+}
+
+TEST_CASE("DAG Paths - Shortest, Longest and Critical") {
+	auto const g = make_build();
+	auto const shortest = gdwg::dag_shortest_paths(g, "fetch");
+	CHECK(shortest.distances[*g.id_of("package")] == 6);
+	CHECK(names(g, shortest.path_to(*g.id_of("package")))
+	      == std::vector<std::string>{"fetch", "configure", "docs", "package"});
+
+	auto const longest = gdwg::dag_longest_paths(g, "fetch");
+	CHECK(longest.distances[*g.id_of("package")] == 19);
+	CHECK(names(g, longest.path_to(*g.id_of("package")))
+	      == std::vector<std::string>{"fetch", "configure", "compile", "test", "package"});
+
+	CHECK(names(g, gdwg::critical_path(g))
+	      == std::vector<std::string>{"fetch", "configure", "compile", "test", "package"});
+
+	auto const from_docs = gdwg::dag_shortest_paths(g, "docs", 5);
+	CHECK(from_docs.distances[*g.id_of("package")] == 5);
+	CHECK(!from_docs.reached(*g.id_of("fetch")));
+	CHECK_THROWS_MATCHES(gdwg::dag_longest_paths(g, "deploy"),
+	                     std::runtime_error,
+	                     Catch::Matchers::Message("Cannot call gdwg::dag_longest_paths if source doesn't exist in the "
+	                                              "graph"));
+}
+
+TEST_CASE("DAG Paths - Negative Weights Match Exhaustive Relaxation") {
+	auto engine = std::mt19937(13);
+	auto weight = std::uniform_int_distribution<int>(-20, 20);
+	auto g = gdwg::graph<int, int>{};
+	auto batch = std::vector<std::tuple<int, int, std::optional<int>>>{};
+	for (auto i = 0; i < 300; ++i) {
+		g.insert_node(i);
+		for (auto j = 0; j < 4; ++j) {
+			auto const to = std::uniform_int_distribution<int>(i, 299)(engine);
+			if (to != i) {
+				batch.emplace_back(i, to, weight(engine));
+			}
+		}
+	}
+	g.insert_edges(batch);
+
+	auto const tree = gdwg::dag_shortest_paths(g, 0);
+	auto distances = std::vector<int>(g.node_count(), gdwg::infinite_distance<int>);
+	distances[*g.id_of(0)] = 0;
+	for (auto round = std::size_t{0}; round < g.node_count(); ++round) {
+		for (auto const& [from, to, w] : g) {
+			auto const u = *g.id_of(from);
+			if (distances[u] != gdwg::infinite_distance<int>) {
+				auto& d = distances[*g.id_of(to)];
+				d = std::min(d, distances[u] + *w);
+			}
+		}
+	}
+	CHECK(tree.distances == distances);
+}
@@ -0,0 +1 @@
+#include "gdwg_edge_list.h"
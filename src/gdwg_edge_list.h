@@ -0,0 +1,236 @@
+#ifndef GDWG_EDGE_LIST_H
+#define GDWG_EDGE_LIST_H
+
+#include "gdwg_graph.h"
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <cstddef>
+#include <exception>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace gdwg {
+	// Fields that read_edge_list can parse: arithmetic types through std::from_chars, and anything
+	// constructible from the field's text, such as std::string.
+	template<typename T>
+	concept edge_list_field = (std::is_arithmetic_v<T> and !std::is_same_v<T, bool>)
+	                          or std::is_constructible_v<T, std::string_view>;
+
+	struct edge_list_options {
+		// Worker threads used to parse each block. Zero uses std::thread::hardware_concurrency().
+		std::size_t threads = 0;
+		// Bytes handed to each worker at a time. A block of threads * chunk_size bytes is read,
+		// parsed and merged into the graph before the next one is read.
+		std::size_t chunk_size = std::size_t{8} << 20;
+		// Lines whose first field starts with this character are skipped.
+		char comment = '#';
+	};
+
+	namespace detail {
+		template<typename N, typename E>
+		struct edge_list_chunk {
+			std::vector<std::tuple<N, N, std::optional<E>>> edges;
+			// Every endpoint in edges, sorted and deduplicated.
+			std::vector<N> nodes;
+			std::size_t lines = 0;
+			// The chunk-relative line that could not be parsed, if any.
+			std::optional<std::size_t> error_line;
+			std::exception_ptr error;
+		};
+
+		inline auto is_edge_list_separator(char c) noexcept -> bool {
+			return c == ' ' or c == '\t' or c == '\r' or c == ',';
+		}
+
+		template<edge_list_field T>
+		auto parse_edge_list_field(std::string_view text) -> std::optional<T> {
+			if constexpr (std::is_arithmetic_v<T>) {
+				auto value = T{};
+				auto const* last = text.data() + text.size();
+				auto [ptr, ec] = std::from_chars(text.data(), last, value);
+				if (ec != std::errc{} or ptr != last) {
+					return std::nullopt;
+				}
+				return value;
+			}
+			else {
+				return T(text);
+			}
+		}
+
+		// Parses whole lines of text into edges, stopping at the first malformed line.
+		template<typename N, typename E>
+		auto parse_edge_list_chunk(std::string_view text, char comment, edge_list_chunk<N, E>& chunk) -> void {
+			auto fields = std::array<std::string_view, 3>{};
+			while (!text.empty()) {
+				auto const newline = text.find('\n');
+				auto line = text.substr(0, newline);
+				text.remove_prefix(newline == std::string_view::npos ? text.size() : newline + 1);
+				++chunk.lines;
+
+				auto i = std::size_t{0};
+				while (i < line.size() and is_edge_list_separator(line[i])) {
+					++i;
+				}
+				if (i == line.size() or line[i] == comment) {
+					continue;
+				}
+
+				auto count = std::size_t{0};
+				while (i < line.size()) {
+					while (i < line.size() and is_edge_list_separator(line[i])) {
+						++i;
+					}
+					auto const first = i;
+					while (i < line.size() and !is_edge_list_separator(line[i])) {
+						++i;
+					}
+					if (first == i) {
+						break;
+					}
+					if (count == fields.size()) {
+						chunk.error_line = chunk.lines;
+						return;
+					}
+					fields[count++] = line.substr(first, i - first);
+				}
+
+				auto src = count == 1 ? std::nullopt : parse_edge_list_field<N>(fields[0]);
+				auto dst = count == 1 ? std::nullopt : parse_edge_list_field<N>(fields[1]);
+				auto weight = count == 3 ? parse_edge_list_field<E>(fields[2]) : std::nullopt;
+				if (!src or !dst or (count == 3 and !weight)) {
+					chunk.error_line = chunk.lines;
+					return;
+				}
+				chunk.nodes.push_back(*src);
+				chunk.nodes.push_back(*dst);
+				chunk.edges.emplace_back(std::move(*src), std::move(*dst), std::move(weight));
+			}
+			std::sort(chunk.nodes.begin(), chunk.nodes.end());
+			chunk.nodes.erase(std::unique(chunk.nodes.begin(), chunk.nodes.end()), chunk.nodes.end());
+		}
+
+		// Splits text into at most parts pieces of roughly equal size that each end on a line boundary.
+		inline auto split_edge_list_block(std::string_view text, std::size_t parts) -> std::vector<std::string_view> {
+			auto pieces = std::vector<std::string_view>{};
+			auto const target = std::max(text.size() / parts, std::size_t{1});
+			while (!text.empty()) {
+				auto cut = text.size();
+				if (pieces.size() + 1 < parts and target < text.size()) {
+					auto const newline = text.find('\n', target);
+					cut = newline == std::string_view::npos ? text.size() : newline + 1;
+				}
+				pieces.push_back(text.substr(0, cut));
+				text.remove_prefix(cut);
+			}
+			return pieces;
+		}
+	} // namespace detail
+
+	// Reads "src dst [weight]" lines from is into g and returns how many new edges were inserted.
+	// Fields are separated by any run of spaces, tabs or commas, so both whitespace- and
+	// CSV-delimited files are accepted. Blank lines and comment lines are skipped. The input is
+	// read in blocks, each parsed by several threads and merged into g with one batched
+	// insert_nodes and insert_edges. Throws std::runtime_error naming the first malformed line.
+	// Blocks before it have already been merged into g by then.
+	template<edge_list_field N, edge_list_field E>
+	auto read_edge_list(std::istream& is, graph<N, E>& g, edge_list_options const& options = {}) -> std::size_t {
+		auto const threads = std::max(std::size_t{1},
+		                              options.threads != 0 ? options.threads
+		                                                   : std::size_t{std::thread::hardware_concurrency()});
+		auto const block_size = threads * std::max(options.chunk_size, std::size_t{1});
+		auto buffer = std::string{};
+		auto lines_before = std::size_t{0};
+		auto inserted = std::size_t{0};
+		auto done = false;
+		while (!done) {
+			auto const carried = buffer.size();
+			buffer.resize(carried + block_size);
+			is.read(buffer.data() + carried, static_cast<std::streamsize>(block_size));
+			buffer.resize(carried + static_cast<std::size_t>(is.gcount()));
+			if (is.bad()) {
+				throw std::runtime_error("Cannot call gdwg::read_edge_list when the input stream fails");
+			}
+			done = is.eof();
+
+			// Parse up to the last complete line and carry the rest into the next block.
+			auto parsed = buffer.size();
+			if (!done) {
+				auto const newline = buffer.rfind('\n');
+				if (newline == std::string::npos) {
+					continue;
+				}
+				parsed = newline + 1;
+			}
+
+			auto const pieces = detail::split_edge_list_block(std::string_view(buffer).substr(0, parsed), threads);
+			auto chunks = std::vector<detail::edge_list_chunk<N, E>>(pieces.size());
+			auto parse = [&](std::size_t i) {
+				try {
+					detail::parse_edge_list_chunk(pieces[i], options.comment, chunks[i]);
+				} catch (...) {
+					chunks[i].error = std::current_exception();
+				}
+			};
+			{
+				auto workers = std::vector<std::jthread>{};
+				workers.reserve(pieces.size());
+				for (auto i = std::size_t{1}; i < pieces.size(); ++i) {
+					workers.emplace_back(parse, i);
+				}
+				if (!pieces.empty()) {
+					parse(0);
+				}
+			}
+
+			auto batch_nodes = std::vector<N>{};
+			auto batch_edges = std::vector<std::tuple<N, N, std::optional<E>>>{};
+			for (auto& chunk : chunks) {
+				if (chunk.error) {
+					std::rethrow_exception(chunk.error);
+				}
+				if (chunk.error_line) {
+					throw std::runtime_error("Cannot call gdwg::read_edge_list when line "
+					                         + std::to_string(lines_before + *chunk.error_line) + " is malformed");
+				}
+				lines_before += chunk.lines;
+				batch_nodes.insert(batch_nodes.end(),
+				                   std::make_move_iterator(chunk.nodes.begin()),
+				                   std::make_move_iterator(chunk.nodes.end()));
+				batch_edges.insert(batch_edges.end(),
+				                   std::make_move_iterator(chunk.edges.begin()),
+				                   std::make_move_iterator(chunk.edges.end()));
+			}
+			g.insert_nodes(batch_nodes);
+			inserted += g.insert_edges(batch_edges);
+			buffer.erase(0, parsed);
+		}
+		return inserted;
+	}
+
+	template<edge_list_field N, edge_list_field E>
+	auto load_edge_list(std::string const& path, edge_list_options const& options = {}) -> graph<N, E> {
+		auto file = std::ifstream(path, std::ios::binary);
+		if (!file) {
+			throw std::runtime_error("Cannot call gdwg::load_edge_list when the file cannot be opened: " + path);
+		}
+		auto g = graph<N, E>{};
+		read_edge_list(file, g, options);
+		return g;
+	}
+} // namespace gdwg
+
+#endif // GDWG_EDGE_LIST_H
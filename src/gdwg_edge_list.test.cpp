@@ -0,0 +1,98 @@
+#include "gdwg_edge_list.h"
+
+#include <catch2/catch.hpp>
+
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <sstream>
+#include <string>
+
+TEST_CASE("Edge List - Whitespace Delimited") {
+	auto is = std::istringstream("# src dst weight\n"
+	                             "1 2 5\n"
+	                             "\n"
+	                             "2\t3\n"
+	                             "  3   1   -2  \r\n"
+	                             "1 2 5\n"
+	                             "3 3");
+	auto g = gdwg::graph<int, int>{};
+	CHECK(gdwg::read_edge_list(is, g) == 4);
+
+	auto expected = gdwg::graph<int, int>{1, 2, 3};
+	expected.insert_edge(1, 2, 5);
+	expected.insert_edge(2, 3);
+	expected.insert_edge(3, 1, -2);
+	expected.insert_edge(3, 3);
+	CHECK(g == expected);
+}
+
+TEST_CASE("Edge List - CSV With String Nodes") {
+	auto is = std::istringstream("sydney,melbourne,7.5\n"
+	                             "melbourne,perth,1.25e2\n"
+	                             "perth,sydney\n");
+	auto g = gdwg::graph<std::string, double>{"adelaide"};
+	CHECK(gdwg::read_edge_list(is, g) == 3);
+	CHECK(g.nodes() == std::vector<std::string>{"adelaide", "melbourne", "perth", "sydney"});
+	CHECK(g.find("melbourne", "perth", 125.0) != g.end());
+	CHECK(g.find("perth", "sydney") != g.end());
+}
+
+TEST_CASE("Edge List - Malformed Lines") {
+	auto g = gdwg::graph<int, int>{};
+	auto options = gdwg::edge_list_options{};
+	options.threads = 3;
+	options.chunk_size = 4;
+
+	auto const text = GENERATE(std::string("1 2\n2 3\n3 x\n4 5\n"),
+	                           std::string("1 2\n2 3\n3\n4 5\n"),
+	                           std::string("1 2\n2 3\n3 4 5 6\n4 5\n"),
+	                           std::string("1 2\n2 3\n3 4 1.5\n4 5\n"));
+	auto is = std::istringstream(text);
+	CHECK_THROWS_MATCHES(gdwg::read_edge_list(is, g, options),
+	                     std::runtime_error,
+	                     Catch::Matchers::Message("Cannot call gdwg::read_edge_list when line 3 is malformed"));
+}
+
+TEST_CASE("Edge List - Parallel Chunks Match Sequential") {
+	auto engine = std::mt19937(11);
+	auto node = std::uniform_int_distribution<int>(0, 499);
+	auto weight = std::uniform_int_distribution<int>(-100, 100);
+	auto text = std::string{};
+	auto expected = gdwg::graph<int, int>{};
+	for (auto i = 0; i < 5000; ++i) {
+		auto const src = node(engine);
+		auto const dst = node(engine);
+		expected.insert_node(src);
+		expected.insert_node(dst);
+		text += std::to_string(src) + ' ' + std::to_string(dst);
+		if (i % 7 == 0) {
+			expected.insert_edge(src, dst);
+		}
+		else {
+			auto const w = weight(engine);
+			expected.insert_edge(src, dst, w);
+			text += ' ' + std::to_string(w);
+		}
+		text += '\n';
+	}
+
+	auto options = gdwg::edge_list_options{};
+	options.threads = GENERATE(std::size_t{1}, std::size_t{4});
+	options.chunk_size = GENERATE(std::size_t{1}, std::size_t{37}, std::size_t{1} << 20);
+	auto is = std::istringstream(text);
+	auto g = gdwg::graph<int, int>{};
+	CHECK(gdwg::read_edge_list(is, g, options) == expected.edge_count());
+	CHECK(g == expected);
+}
+
+TEST_CASE("Edge List - Load From File") {
+	auto const path = (std::filesystem::temp_directory_path() / "gdwg_edge_list_test.txt").string();
+	std::ofstream(path) << "a b 1\nb c 2\nc a\n";
+	auto const g = gdwg::load_edge_list<std::string, int>(path);
+	std::filesystem::remove(path);
+	CHECK(g.edge_count() == 3);
+	CHECK(g.is_connected("c", "a"));
+
+	CHECK_THROWS_AS((gdwg::load_edge_list<std::string, int>(path)), std::runtime_error);
+}
@@ -0,0 +1 @@
+#include "gdwg_flow.h"
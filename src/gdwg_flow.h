@@ -0,0 +1,573 @@
+#ifndef GDWG_FLOW_H
+#define GDWG_FLOW_H
+
+#include "gdwg_graph.h"
+#include "gdwg_shortest_paths.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace gdwg {
+	enum class max_flow_algorithm { dinic, push_relabel };
+
+	template<typename E>
+	struct max_flow_options {
+		// The capacity of an unweighted edge.
+		E unweighted_capacity = E{1};
+		max_flow_algorithm algorithm = max_flow_algorithm::dinic;
+	};
+
+	template<typename E>
+	struct max_flow_result {
+		E value = E{0};
+		// Whether each node, by dense id, is on the source side of the minimum cut: it cannot reach
+		// the sink in the final residual network.
+		std::vector<char> source_side;
+		// Every (from, to) pair of node ids with an edge crossing the cut from the source side to the
+		// sink side, in ascending order. Each pair is listed once however many edges join it.
+		std::vector<std::pair<std::uint32_t, std::uint32_t>> cut;
+	};
+
+	namespace detail {
+		// A residual network in flat arrays. The arcs leaving u occupy [offsets[u], offsets[u + 1]),
+		// sorted by head, with exactly one arc for every node u is joined to in either direction.
+		// Parallel edges are summed into one capacity, and the arc from v back to u doubles as the
+		// reverse of the arc from u to v, at index reverse[a].
+		template<typename E>
+		struct flow_network {
+			std::vector<std::size_t> offsets;
+			std::vector<std::uint32_t> heads;
+			std::vector<std::size_t> reverse;
+			std::vector<E> capacities;
+
+			[[nodiscard]] auto node_count() const noexcept -> std::size_t {
+				return offsets.size() - 1;
+			}
+		};
+
+		template<typename N, typename E>
+		auto make_flow_network(graph<N, E> const& g, E const& unweighted_capacity) -> flow_network<E> {
+			using node_id = std::uint32_t;
+			auto const n = g.node_count();
+			auto network = flow_network<E>{};
+			network.offsets.assign(n + 1, 0);
+			for (auto u = node_id{0}; u < n; ++u) {
+				auto const edges = g.out_edges(u);
+				auto const sources = g.in_edges(u);
+				auto& heads = network.heads;
+				auto const first = heads.size();
+				for (auto const& record : edges) {
+					heads.push_back(record.dst);
+				}
+				heads.insert(heads.end(), sources.begin(), sources.end());
+				auto const begin = heads.begin() + static_cast<std::ptrdiff_t>(first);
+				std::sort(begin, heads.end());
+				heads.erase(std::unique(begin, heads.end()), heads.end());
+				// Self-loops carry no flow.
+				heads.erase(std::remove(begin, heads.end(), u), heads.end());
+				network.offsets[u + 1] = heads.size();
+
+				network.capacities.resize(heads.size(), E{0});
+				// Arcs are in id order but out_edges is in value order, so each edge looks up its arc.
+				auto const row_begin = heads.begin() + static_cast<std::ptrdiff_t>(first);
+				for (auto const& record : edges) {
+					auto const capacity = edge_cost(record, unweighted_capacity);
+					check_non_negative(capacity, "gdwg::max_flow");
+					if (record.dst == u) {
+						continue;
+					}
+					auto const arc = std::lower_bound(row_begin, heads.end(), record.dst) - heads.begin();
+					network.capacities[static_cast<std::size_t>(arc)] += capacity;
+				}
+			}
+			network.reverse.resize(network.heads.size());
+			auto const heads_begin = network.heads.begin();
+			for (auto u = node_id{0}; u < n; ++u) {
+				for (auto a = network.offsets[u]; a < network.offsets[u + 1]; ++a) {
+					auto const v = network.heads[a];
+					auto const first = heads_begin + static_cast<std::ptrdiff_t>(network.offsets[v]);
+					auto const last = heads_begin + static_cast<std::ptrdiff_t>(network.offsets[v + 1]);
+					network.reverse[a] = static_cast<std::size_t>(std::lower_bound(first, last, u) - heads_begin);
+				}
+			}
+			return network;
+		}
+
+		// Dinic's algorithm: breadth-first levels from the source, then a blocking flow along level
+		// edges. Each node keeps a current arc, so an arc found useless is never scanned again in the
+		// same phase. The search keeps an explicit path instead of recursing.
+		template<typename E>
+		auto dinic(flow_network<E>& network, std::uint32_t source, std::uint32_t sink) -> E {
+			using node_id = std::uint32_t;
+			constexpr auto unreached = std::numeric_limits<std::size_t>::max();
+			auto const n = network.node_count();
+			auto& capacities = network.capacities;
+			auto level = std::vector<std::size_t>(n);
+			auto current = std::vector<std::size_t>(n);
+			auto queue = std::vector<node_id>{};
+			auto path = std::vector<std::size_t>{};
+			auto value = E{0};
+			for (;;) {
+				std::fill(level.begin(), level.end(), unreached);
+				level[source] = 0;
+				queue.assign(1, source);
+				for (auto head = std::size_t{0}; head < queue.size() and level[sink] == unreached; ++head) {
+					auto const u = queue[head];
+					for (auto a = network.offsets[u]; a < network.offsets[u + 1]; ++a) {
+						auto const v = network.heads[a];
+						if (capacities[a] > E{0} and level[v] == unreached) {
+							level[v] = level[u] + 1;
+							queue.push_back(v);
+						}
+					}
+				}
+				if (level[sink] == unreached) {
+					return value;
+				}
+
+				std::copy(network.offsets.begin(), network.offsets.end() - 1, current.begin());
+				path.clear();
+				auto u = source;
+				for (;;) {
+					if (u == sink) {
+						auto bottleneck = capacities[path.front()];
+						for (auto a : path) {
+							bottleneck = std::min(bottleneck, capacities[a]);
+						}
+						auto saturated = path.size();
+						for (auto i = std::size_t{0}; i < path.size(); ++i) {
+							capacities[path[i]] -= bottleneck;
+							capacities[network.reverse[path[i]]] += bottleneck;
+							if (capacities[path[i]] == E{0} and saturated == path.size()) {
+								saturated = i;
+							}
+						}
+						value += bottleneck;
+						// Resume from the tail of the first saturated arc.
+						path.resize(saturated);
+						u = path.empty() ? source : network.heads[path.back()];
+						continue;
+					}
+					auto& a = current[u];
+					while (a < network.offsets[u + 1]
+					       and (capacities[a] == E{0} or level[network.heads[a]] != level[u] + 1))
+					{
+						++a;
+					}
+					if (a < network.offsets[u + 1]) {
+						path.push_back(a);
+						u = network.heads[a];
+						continue;
+					}
+					// A dead end: retreat and skip the arc that led here.
+					if (u == source) {
+						break;
+					}
+					level[u] = unreached;
+					path.pop_back();
+					u = path.empty() ? source : network.heads[path.back()];
+					++current[u];
+				}
+			}
+		}
+
+		// Highest-label push-relabel. Only the first phase runs, which leaves a maximum preflow whose
+		// excess at the sink is the flow value. Active nodes wait in buckets by height and the
+		// highest is always discharged first. Heights are recomputed exactly by a backward search
+		// from the sink at the start and after every n relabels.
+		template<typename E>
+		auto push_relabel(flow_network<E>& network, std::uint32_t source, std::uint32_t sink) -> E {
+			using node_id = std::uint32_t;
+			auto const n = network.node_count();
+			auto& capacities = network.capacities;
+			auto height = std::vector<std::size_t>(n, 0);
+			auto excess = std::vector<E>(n, E{0});
+			auto current = std::vector<std::size_t>(n);
+			auto buckets = std::vector<std::vector<node_id>>(n);
+			auto highest = std::size_t{0};
+			auto queue = std::vector<node_id>{};
+
+			auto const is_active = [&](node_id v) {
+				return v != source and v != sink and excess[v] > E{0} and height[v] < n;
+			};
+			auto const activate = [&](node_id v) {
+				buckets[height[v]].push_back(v);
+				highest = std::max(highest, height[v]);
+			};
+			auto const global_relabel = [&] {
+				std::fill(height.begin(), height.end(), n);
+				height[sink] = 0;
+				queue.assign(1, sink);
+				for (auto head = std::size_t{0}; head < queue.size(); ++head) {
+					auto const w = queue[head];
+					for (auto a = network.offsets[w]; a < network.offsets[w + 1]; ++a) {
+						auto const v = network.heads[a];
+						if (height[v] == n and v != source and capacities[network.reverse[a]] > E{0}) {
+							height[v] = height[w] + 1;
+							queue.push_back(v);
+						}
+					}
+				}
+				for (auto& bucket : buckets) {
+					bucket.clear();
+				}
+				highest = 0;
+				for (auto v = node_id{0}; v < n; ++v) {
+					current[v] = network.offsets[v];
+					if (is_active(v)) {
+						activate(v);
+					}
+				}
+			};
+			auto const push = [&](node_id u, std::size_t a, E amount) {
+				auto const v = network.heads[a];
+				capacities[a] -= amount;
+				capacities[network.reverse[a]] += amount;
+				excess[u] -= amount;
+				auto const was_idle = !is_active(v);
+				excess[v] += amount;
+				if (was_idle and is_active(v)) {
+					activate(v);
+				}
+			};
+
+			for (auto a = network.offsets[source]; a < network.offsets[source + 1]; ++a) {
+				excess[source] += capacities[a];
+				push(source, a, capacities[a]);
+			}
+			global_relabel();
+			auto relabels = std::size_t{0};
+			for (;;) {
+				while (highest > 0 and buckets[highest].empty()) {
+					--highest;
+				}
+				if (buckets[highest].empty()) {
+					return excess[sink];
+				}
+				auto const u = buckets[highest].back();
+				buckets[highest].pop_back();
+				while (excess[u] > E{0} and height[u] < n) {
+					auto& a = current[u];
+					if (a == network.offsets[u + 1]) {
+						auto lowest = n;
+						for (auto b = network.offsets[u]; b < network.offsets[u + 1]; ++b) {
+							if (capacities[b] > E{0}) {
+								lowest = std::min(lowest, height[network.heads[b]] + 1);
+							}
+						}
+						height[u] = std::min(lowest, n);
+						a = network.offsets[u];
+						++relabels;
+						continue;
+					}
+					auto const v = network.heads[a];
+					if (capacities[a] > E{0} and height[u] == height[v] + 1) {
+						push(u, a, std::min(excess[u], capacities[a]));
+						if (capacities[a] == E{0}) {
+							++a;
+						}
+					}
+					else {
+						++a;
+					}
+				}
+				if (relabels >= n) {
+					relabels = 0;
+					global_relabel();
+				}
+				else if (is_active(u)) {
+					activate(u);
+				}
+			}
+		}
+	} // namespace detail
+
+	// Maximum flow from source to sink, reading edge weights as capacities. Parallel edges between
+	// the same pair add up, and self-loops are ignored. Also returns a minimum cut. Throws
+	// std::runtime_error if source or sink is not a node, if they are the same node, or if any
+	// capacity is negative.
+	template<typename N, typename E>
+	requires std::is_arithmetic_v<E>
+	auto max_flow(graph<N, E> const& g,
+	              std::type_identity_t<N> const& source,
+	              std::type_identity_t<N> const& sink,
+	              max_flow_options<E> const& options = {}) -> max_flow_result<E> {
+		using node_id = std::uint32_t;
+		constexpr auto missing = "Cannot call gdwg::max_flow if source or sink doesn't exist in the graph";
+		auto const s = detail::id_or_throw(g, source, missing);
+		auto const t = detail::id_or_throw(g, sink, missing);
+		if (s == t) {
+			throw std::runtime_error("Cannot call gdwg::max_flow with the same source and sink");
+		}
+		auto network = detail::make_flow_network(g, options.unweighted_capacity);
+		auto const original = network.capacities;
+		auto result = max_flow_result<E>{};
+		result.value = options.algorithm == max_flow_algorithm::dinic ? detail::dinic(network, s, t)
+		                                                              : detail::push_relabel(network, s, t);
+
+		// Every node that can still reach the sink is on the sink side.
+		auto const n = network.node_count();
+		result.source_side.assign(n, 1);
+		result.source_side[t] = 0;
+		auto queue = std::vector<node_id>{t};
+		for (auto head = std::size_t{0}; head < queue.size(); ++head) {
+			auto const w = queue[head];
+			for (auto a = network.offsets[w]; a < network.offsets[w + 1]; ++a) {
+				auto const v = network.heads[a];
+				if (result.source_side[v] != 0 and network.capacities[network.reverse[a]] > E{0}) {
+					result.source_side[v] = 0;
+					queue.push_back(v);
+				}
+			}
+		}
+		for (auto u = node_id{0}; u < n; ++u) {
+			if (result.source_side[u] == 0) {
+				continue;
+			}
+			for (auto a = network.offsets[u]; a < network.offsets[u + 1]; ++a) {
+				if (result.source_side[network.heads[a]] == 0 and original[a] > E{0}) {
+					result.cut.emplace_back(u, network.heads[a]);
+				}
+			}
+		}
+		return result;
+	}
+
+	template<typename Cost, typename Capacity>
+	struct min_cost_flow_result {
+		Capacity flow = Capacity{0};
+		Cost cost = Cost{0};
+		// The flow on every edge, in the order the graph iterates its edges (by source value, then
+		// destination value, then weight), which is also the edge order of csr_graph.
+		std::vector<Capacity> edge_flows;
+	};
+
+	namespace detail {
+		// The terms an accessor reads out of a weight: access(weight) returns a (cost, capacity)
+		// pair.
+		template<typename Access, typename E>
+		using flow_terms = std::invoke_result_t<Access&, E const&>;
+
+		template<typename Access, typename E>
+		using flow_cost_t = typename flow_terms<Access, E>::first_type;
+
+		template<typename Access, typename E>
+		using flow_capacity_t = typename flow_terms<Access, E>::second_type;
+
+		// A residual network with one arc pair per edge, since parallel edges may differ in cost.
+		// The arcs leaving u occupy [offsets[u], offsets[u + 1]). edges[a] is the position of the
+		// edge an arc carries forwards, or no_edge for a reverse arc.
+		template<typename Cost, typename Capacity>
+		struct cost_network {
+			static constexpr auto no_edge = std::numeric_limits<std::size_t>::max();
+
+			std::vector<std::size_t> offsets;
+			std::vector<std::uint32_t> heads;
+			std::vector<std::size_t> reverse;
+			std::vector<Capacity> capacities;
+			std::vector<Cost> costs;
+			std::vector<std::size_t> edges;
+		};
+
+		template<typename N, typename E, typename Access>
+		auto make_cost_network(graph<N, E> const& g, Access& access)
+		    -> cost_network<flow_cost_t<Access, E>, flow_capacity_t<Access, E>> {
+			using node_id = std::uint32_t;
+			using cost_type = flow_cost_t<Access, E>;
+			using capacity_type = flow_capacity_t<Access, E>;
+			auto const n = g.node_count();
+			auto network = cost_network<cost_type, capacity_type>{};
+			network.offsets.assign(n + 1, 0);
+			for (auto u = node_id{0}; u < n; ++u) {
+				network.offsets[u + 1] = network.offsets[u] + g.out_edges(u).size() + g.in_edges(u).size();
+			}
+			auto const arcs = network.offsets[n];
+			network.heads.resize(arcs);
+			network.reverse.resize(arcs);
+			network.capacities.resize(arcs, capacity_type{0});
+			network.costs.resize(arcs, cost_type{0});
+			network.edges.resize(arcs, network.no_edge);
+			auto cursor = std::vector<std::size_t>(network.offsets.begin(), network.offsets.end() - 1);
+			// Each id's out_edges row is already in iteration order, but the rows come by source value.
+			auto first_edge = std::vector<std::size_t>(n);
+			auto position = std::size_t{0};
+			for (auto const& value : g.nodes()) {
+				auto const u = *g.id_of(value);
+				first_edge[u] = position;
+				position += g.out_edges(u).size();
+			}
+			for (auto u = node_id{0}; u < n; ++u) {
+				auto edge = first_edge[u];
+				for (auto const& record : g.out_edges(u)) {
+					auto const forward = cursor[u]++;
+					auto const backward = cursor[record.dst]++;
+					network.heads[forward] = record.dst;
+					network.heads[backward] = u;
+					network.reverse[forward] = backward;
+					network.reverse[backward] = forward;
+					network.edges[forward] = edge++;
+					// Unweighted edges and self-loops carry no flow.
+					if (!record.weight or record.dst == u) {
+						continue;
+					}
+					auto const [cost, capacity] = access(*record.weight);
+					check_non_negative(capacity, "gdwg::min_cost_flow");
+					network.capacities[forward] = capacity;
+					network.costs[forward] = cost;
+					network.costs[backward] = -cost;
+				}
+			}
+			return network;
+		}
+
+		// Initial potentials by Bellman-Ford over the arcs with capacity, needed only when some
+		// cost is negative. Throws if a negative-cost cycle is reachable from source.
+		template<typename Cost, typename Capacity>
+		auto initial_potentials(cost_network<Cost, Capacity> const& network, std::uint32_t source)
+		    -> std::vector<Cost> {
+			using node_id = std::uint32_t;
+			auto const n = network.offsets.size() - 1;
+			auto potentials = std::vector<Cost>(n, Cost{0});
+			// Reverse arcs carry negated costs, so only forward arcs say whether any edge is negative.
+			auto negative = false;
+			for (auto a = std::size_t{0}; a < network.costs.size() and !negative; ++a) {
+				negative = network.edges[a] != network.no_edge and network.costs[a] < Cost{0};
+			}
+			if (!negative) {
+				return potentials;
+			}
+			std::fill(potentials.begin(), potentials.end(), infinite_distance<Cost>);
+			potentials[source] = Cost{0};
+			for (auto round = std::size_t{0}; round < n; ++round) {
+				auto changed = false;
+				for (auto u = node_id{0}; u < n; ++u) {
+					if (potentials[u] == infinite_distance<Cost>) {
+						continue;
+					}
+					for (auto a = network.offsets[u]; a < network.offsets[u + 1]; ++a) {
+						auto const candidate = potentials[u] + network.costs[a];
+						auto& current = potentials[network.heads[a]];
+						if (network.capacities[a] > Capacity{0} and candidate < current) {
+							current = candidate;
+							changed = true;
+						}
+					}
+				}
+				if (!changed) {
+					return potentials;
+				}
+			}
+			throw std::runtime_error("Cannot call gdwg::min_cost_flow on a graph with a negative-cost cycle");
+		}
+	} // namespace detail
+
+	// Minimum-cost flow from source to sink by successive shortest paths. access(weight) returns a
+	// (cost, capacity) pair for each edge, so weights can be any type that carries both. Each round
+	// runs Dijkstra on costs reduced by Johnson potentials, which keeps them non-negative, and
+	// pushes as much as the cheapest path allows. Sends as much flow as possible up to limit.
+	// Unweighted edges and self-loops carry no flow. Negative costs are allowed, but not a
+	// negative-cost cycle reachable from source.
+	template<typename N, typename E, typename Access>
+	requires std::is_signed_v<detail::flow_cost_t<Access, E>>
+	         and std::is_arithmetic_v<detail::flow_capacity_t<Access, E>>
+	auto min_cost_flow(graph<N, E> const& g,
+	                   std::type_identity_t<N> const& source,
+	                   std::type_identity_t<N> const& sink,
+	                   Access access,
+	                   detail::flow_capacity_t<Access, E> limit)
+	    -> min_cost_flow_result<detail::flow_cost_t<Access, E>, detail::flow_capacity_t<Access, E>> {
+		using node_id = std::uint32_t;
+		using cost_type = detail::flow_cost_t<Access, E>;
+		using capacity_type = detail::flow_capacity_t<Access, E>;
+		constexpr auto missing = "Cannot call gdwg::min_cost_flow if source or sink doesn't exist in the graph";
+		auto const s = detail::id_or_throw(g, source, missing);
+		auto const t = detail::id_or_throw(g, sink, missing);
+		if (s == t) {
+			throw std::runtime_error("Cannot call gdwg::min_cost_flow with the same source and sink");
+		}
+		auto network = detail::make_cost_network(g, access);
+		auto potentials = detail::initial_potentials(network, s);
+		auto const n = g.node_count();
+		auto result = min_cost_flow_result<cost_type, capacity_type>{};
+		auto distances = std::vector<cost_type>(n);
+		auto via = std::vector<std::size_t>(n);
+		auto settled = std::vector<char>(n);
+		auto heap = detail::binary_heap<cost_type>(n);
+		while (result.flow < limit) {
+			std::fill(distances.begin(), distances.end(), infinite_distance<cost_type>);
+			std::fill(settled.begin(), settled.end(), 0);
+			distances[s] = cost_type{0};
+			heap.push(s, cost_type{0});
+			while (!heap.empty()) {
+				auto const u = heap.pop();
+				if (settled[u] != 0) {
+					continue;
+				}
+				settled[u] = 1;
+				for (auto a = network.offsets[u]; a < network.offsets[u + 1]; ++a) {
+					auto const v = network.heads[a];
+					if (network.capacities[a] == capacity_type{0} or settled[v] != 0) {
+						continue;
+					}
+					auto const candidate = distances[u] + network.costs[a] + potentials[u] - potentials[v];
+					if (candidate < distances[v]) {
+						distances[v] = candidate;
+						via[v] = a;
+						heap.push(v, candidate);
+					}
+				}
+			}
+			if (settled[t] == 0) {
+				break;
+			}
+			// Nodes left unreached stay unreachable, so only settled potentials need to move.
+			for (auto v = node_id{0}; v < n; ++v) {
+				if (settled[v] != 0) {
+					potentials[v] += distances[v];
+				}
+			}
+
+			auto amount = limit - result.flow;
+			for (auto v = t; v != s; v = network.heads[network.reverse[via[v]]]) {
+				amount = std::min(amount, network.capacities[via[v]]);
+			}
+			for (auto v = t; v != s; v = network.heads[network.reverse[via[v]]]) {
+				auto const a = via[v];
+				network.capacities[a] -= amount;
+				network.capacities[network.reverse[a]] += amount;
+				result.cost += static_cast<cost_type>(amount) * network.costs[a];
+			}
+			result.flow += amount;
+		}
+
+		result.edge_flows.assign(g.edge_count(), capacity_type{0});
+		for (auto a = std::size_t{0}; a < network.edges.size(); ++a) {
+			if (network.edges[a] != network.no_edge) {
+				// Whatever has been pushed along an arc sits on its reverse.
+				result.edge_flows[network.edges[a]] = network.capacities[network.reverse[a]];
+			}
+		}
+		return result;
+	}
+
+	// A minimum-cost maximum flow.
+	template<typename N, typename E, typename Access>
+	requires std::is_signed_v<detail::flow_cost_t<Access, E>>
+	         and std::is_arithmetic_v<detail::flow_capacity_t<Access, E>>
+	auto min_cost_flow(graph<N, E> const& g,
+	                   std::type_identity_t<N> const& source,
+	                   std::type_identity_t<N> const& sink,
+	                   Access access)
+	    -> min_cost_flow_result<detail::flow_cost_t<Access, E>, detail::flow_capacity_t<Access, E>> {
+		using capacity_type = detail::flow_capacity_t<Access, E>;
+		return min_cost_flow(g, source, sink, std::move(access), std::numeric_limits<capacity_type>::max());
+	}
+} // namespace gdwg
+
+#endif // GDWG_FLOW_H
@@ -0,0 +1,370 @@
+#include "gdwg_flow.h"
+
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+#include <limits>
+#include <map>
+#include <numeric>
+#include <optional>
+#include <random>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace {
+	auto random_network(unsigned seed, int nodes, int edges) -> gdwg::graph<int, long> {
+		auto engine = std::mt19937(seed);
+		auto node = std::uniform_int_distribution<int>(0, nodes - 1);
+		auto capacity = std::uniform_int_distribution<long>(0, 20);
+		// Shuffled so that dense ids are out of value order, as they are in general.
+		auto order = std::vector<int>(static_cast<std::size_t>(nodes));
+		std::iota(order.begin(), order.end(), 0);
+		std::shuffle(order.begin(), order.end(), engine);
+		auto g = gdwg::graph<int, long>{};
+		for (auto i : order) {
+			g.insert_node(i);
+		}
+		auto batch = std::vector<std::tuple<int, int, std::optional<long>>>{};
+		for (auto i = 0; i < edges; ++i) {
+			batch.emplace_back(node(engine), node(engine), capacity(engine));
+		}
+		g.insert_edges(batch);
+		return g;
+	}
+
+	// Edmonds-Karp over a dense capacity matrix, for comparison.
+	auto reference_max_flow(gdwg::graph<int, long> const& g, std::uint32_t s, std::uint32_t t) -> long {
+		auto const n = g.node_count();
+		auto capacity = std::vector<std::vector<long>>(n, std::vector<long>(n, 0));
+		for (auto u = std::uint32_t{0}; u < n; ++u) {
+			for (auto const& record : g.out_edges(u)) {
+				if (record.dst != u) {
+					capacity[u][record.dst] += record.weight.value_or(1);
+				}
+			}
+		}
+		auto value = 0L;
+		for (;;) {
+			auto parent = std::vector<std::size_t>(n, n);
+			parent[s] = s;
+			auto queue = std::vector<std::size_t>{s};
+			for (auto head = std::size_t{0}; head < queue.size() and parent[t] == n; ++head) {
+				for (auto v = std::size_t{0}; v < n; ++v) {
+					if (parent[v] == n and capacity[queue[head]][v] > 0) {
+						parent[v] = queue[head];
+						queue.push_back(v);
+					}
+				}
+			}
+			if (parent[t] == n) {
+				return value;
+			}
+			auto bottleneck = std::numeric_limits<long>::max();
+			for (auto v = std::size_t{t}; v != s; v = parent[v]) {
+				bottleneck = std::min(bottleneck, capacity[parent[v]][v]);
+			}
+			for (auto v = std::size_t{t}; v != s; v = parent[v]) {
+				capacity[parent[v]][v] -= bottleneck;
+				capacity[v][parent[v]] += bottleneck;
+			}
+			value += bottleneck;
+		}
+	}
+
+	// The total capacity of every edge from the source side to the sink side.
+	auto cut_capacity(gdwg::graph<int, long> const& g, gdwg::max_flow_result<long> const& result) -> long {
+		auto total = 0L;
+		for (auto u = std::uint32_t{0}; u < g.node_count(); ++u) {
+			for (auto const& record : g.out_edges(u)) {
+				if (result.source_side[u] != 0 and result.source_side[record.dst] == 0) {
+					total += record.weight.value_or(1);
+				}
+			}
+		}
+		return total;
+	}
+} // namespace
+
+TEST_CASE("Max Flow - Capacity Network With Parallel Edges") {
+	auto g = gdwg::graph<std::string, long>{"s", "a", "b", "t"};
+	g.insert_edge("s", "a", 3);
+	g.insert_edge("s", "a", 4);
+	g.insert_edge("s", "b", 5);
+	g.insert_edge("a", "b", 2);
+	g.insert_edge("b", "a", 1);
+	g.insert_edge("a", "t", 6);
+	g.insert_edge("b", "t", 4);
+	g.insert_edge("b", "t", 1);
+	g.insert_edge("t", "t", 100);
+	auto options = gdwg::max_flow_options<long>{};
+	options.algorithm = GENERATE(gdwg::max_flow_algorithm::dinic, gdwg::max_flow_algorithm::push_relabel);
+	auto const result = gdwg::max_flow(g, "s", "t", options);
+	CHECK(result.value == 11);
+	auto const id = [&g](std::string const& name) { return *g.id_of(name); };
+	CHECK(result.source_side[id("s")] != 0);
+	CHECK(result.source_side[id("t")] == 0);
+	auto expected_cut = std::vector<std::pair<std::uint32_t, std::uint32_t>>{};
+	for (auto u = std::uint32_t{0}; u < g.node_count(); ++u) {
+		for (auto const& record : g.out_edges(u)) {
+			if (result.source_side[u] != 0 and result.source_side[record.dst] == 0
+			    and (expected_cut.empty() or expected_cut.back() != std::pair{u, record.dst}))
+			{
+				expected_cut.emplace_back(u, record.dst);
+			}
+		}
+	}
+	CHECK(result.cut == expected_cut);
+}
+
+TEST_CASE("Max Flow - Node Ids Out Of Value Order") {
+	auto g = gdwg::graph<std::string, int>{"s", "d", "c", "b", "a", "t"};
+	g.insert_edge("s", "a", 3);
+	g.insert_edge("s", "b", 4);
+	g.insert_edge("s", "c", 5);
+	g.insert_edge("s", "d", 6);
+	g.insert_edge("a", "t", 2);
+	g.insert_edge("b", "t", 4);
+	g.insert_edge("c", "t", 10);
+	g.insert_edge("d", "t", 1);
+	auto options = gdwg::max_flow_options<int>{};
+	options.algorithm = GENERATE(gdwg::max_flow_algorithm::dinic, gdwg::max_flow_algorithm::push_relabel);
+	auto const result = gdwg::max_flow(g, "s", "t", options);
+	CHECK(result.value == 12);
+	// c still has spare capacity into t, while a, b and d are saturated.
+	CHECK(result.source_side[*g.id_of("a")] != 0);
+	CHECK(result.source_side[*g.id_of("c")] == 0);
+}
+
+TEST_CASE("Max Flow - Algorithms Match A Reference") {
+	auto const edges = GENERATE(100, 400, 1500);
+	auto const g = random_network(static_cast<unsigned>(edges), 60, edges);
+	auto engine = std::mt19937(static_cast<unsigned>(edges) * 7);
+	auto node = std::uniform_int_distribution<int>(0, 59);
+	for (auto trial = 0; trial < 5; ++trial) {
+		auto const s = node(engine);
+		auto t = node(engine);
+		if (t == s) {
+			t = (s + 1) % 60;
+		}
+		auto const expected = reference_max_flow(g, *g.id_of(s), *g.id_of(t));
+		for (auto algorithm : {gdwg::max_flow_algorithm::dinic, gdwg::max_flow_algorithm::push_relabel}) {
+			auto options = gdwg::max_flow_options<long>{};
+			options.algorithm = algorithm;
+			auto const result = gdwg::max_flow(g, s, t, options);
+			CHECK(result.value == expected);
+			CHECK(cut_capacity(g, result) == expected);
+			CHECK(result.source_side[*g.id_of(s)] != 0);
+			CHECK(result.source_side[*g.id_of(t)] == 0);
+		}
+	}
+}
+
+TEST_CASE("Max Flow - Long Paths Do Not Recurse") {
+	constexpr auto length = 100000;
+	auto g = gdwg::graph<int, long>{};
+	auto nodes = std::vector<int>(length);
+	auto batch = std::vector<std::tuple<int, int, std::optional<long>>>{};
+	for (auto i = 0; i < length; ++i) {
+		nodes[static_cast<std::size_t>(i)] = i;
+		if (i + 1 < length) {
+			batch.emplace_back(i, i + 1, i == length / 2 ? 3 : 9);
+			batch.emplace_back(i, i + 1, std::nullopt);
+		}
+	}
+	g.insert_nodes(nodes);
+	g.insert_edges(batch);
+	auto options = gdwg::max_flow_options<long>{};
+	options.algorithm = GENERATE(gdwg::max_flow_algorithm::dinic, gdwg::max_flow_algorithm::push_relabel);
+	auto const result = gdwg::max_flow(g, 0, length - 1, options);
+	CHECK(result.value == 4);
+	CHECK(result.cut == std::vector<std::pair<std::uint32_t, std::uint32_t>>{{length / 2, length / 2 + 1}});
+}
+
+TEST_CASE("Max Flow - Disconnected And Errors") {
+	auto g = gdwg::graph<int, long>{1, 2, 3};
+	g.insert_edge(2, 1, 5);
+	auto const result = gdwg::max_flow(g, 1, 2);
+	CHECK(result.value == 0);
+	CHECK(result.cut.empty());
+
+	CHECK_THROWS_MATCHES(gdwg::max_flow(g, 1, 4),
+	                     std::runtime_error,
+	                     Catch::Matchers::Message("Cannot call gdwg::max_flow if source or sink doesn't exist in the "
+	                                              "graph"));
+	CHECK_THROWS_MATCHES(gdwg::max_flow(g, 3, 3),
+	                     std::runtime_error,
+	                     Catch::Matchers::Message("Cannot call gdwg::max_flow with the same source and sink"));
+	g.insert_edge(1, 3, -1);
+	CHECK_THROWS_MATCHES(gdwg::max_flow(g, 1, 2),
+	                     std::runtime_error,
+	                     Catch::Matchers::Message("Cannot call gdwg::max_flow on a graph with negative edge weights"));
+}
+
+namespace {
+	struct lane {
+		long cost;
+		long capacity;
+
+		auto operator<=>(lane const&) const = default;
+	};
+
+	auto lane_terms(lane const& weight) -> std::pair<long, long> {
+		return {weight.cost, weight.capacity};
+	}
+
+	auto random_lanes(unsigned seed, int nodes, int edges, long min_cost) -> gdwg::graph<int, lane> {
+		auto engine = std::mt19937(seed);
+		auto node = std::uniform_int_distribution<int>(0, nodes - 1);
+		auto cost = std::uniform_int_distribution<long>(min_cost, 15);
+		auto capacity = std::uniform_int_distribution<long>(1, 10);
+		auto order = std::vector<int>(static_cast<std::size_t>(nodes));
+		std::iota(order.begin(), order.end(), 0);
+		std::shuffle(order.begin(), order.end(), engine);
+		auto g = gdwg::graph<int, lane>{};
+		for (auto i : order) {
+			g.insert_node(i);
+		}
+		for (auto i = 0; i < edges; ++i) {
+			auto const src = node(engine);
+			auto const dst = node(engine);
+			// Edges only run forwards, so negative costs cannot form a cycle.
+			if (src != dst) {
+				g.insert_edge(std::min(src, dst), std::max(src, dst), lane{cost(engine), capacity(engine)});
+			}
+		}
+		return g;
+	}
+
+	// Checks that edge_flows is a feasible flow of the reported value and cost, and that it is
+	// optimal: its residual network has no negative-cost cycle.
+	auto check_min_cost(gdwg::graph<int, lane> const& g,
+	                    std::uint32_t s,
+	                    std::uint32_t t,
+	                    gdwg::min_cost_flow_result<long, long> const& result) -> void {
+		auto const n = g.node_count();
+		auto balance = std::vector<long>(n, 0);
+		auto cost = 0L;
+		// (from, to, cost) for every residual arc.
+		auto residual = std::vector<std::tuple<std::uint32_t, std::uint32_t, long>>{};
+		auto edge = std::size_t{0};
+		for (auto const& [from, to, weight] : g) {
+			auto const u = *g.id_of(from);
+			auto const v = *g.id_of(to);
+			auto const flow = result.edge_flows[edge++];
+			REQUIRE(flow >= 0);
+			REQUIRE(flow <= weight->capacity);
+			balance[u] -= flow;
+			balance[v] += flow;
+			cost += flow * weight->cost;
+			if (flow < weight->capacity) {
+				residual.emplace_back(u, v, weight->cost);
+			}
+			if (flow > 0) {
+				residual.emplace_back(v, u, -weight->cost);
+			}
+		}
+		for (auto v = std::uint32_t{0}; v < n; ++v) {
+			auto const expected = v == s ? -result.flow : v == t ? result.flow : 0;
+			CHECK(balance[v] == expected);
+		}
+		CHECK(cost == result.cost);
+
+		auto distances = std::vector<long>(n, 0);
+		auto changed = true;
+		for (auto round = std::size_t{0}; round <= n and changed; ++round) {
+			changed = false;
+			for (auto const& [from, to, arc_cost] : residual) {
+				if (distances[from] + arc_cost < distances[to]) {
+					distances[to] = distances[from] + arc_cost;
+					changed = true;
+				}
+			}
+		}
+		CHECK(!changed);
+	}
+} // namespace
+
+TEST_CASE("Min Cost Flow - Cheapest Routes First") {
+	auto g = gdwg::graph<std::string, lane>{"s", "a", "b", "t"};
+	g.insert_edge("s", "a", lane{1, 4});
+	g.insert_edge("s", "b", lane{2, 2});
+	g.insert_edge("a", "b", lane{1, 2});
+	g.insert_edge("a", "t", lane{3, 3});
+	g.insert_edge("b", "t", lane{1, 5});
+	g.insert_edge("b", "t", lane{9, 5});
+	auto const result = gdwg::min_cost_flow(g, "s", "t", lane_terms);
+	CHECK(result.flow == 6);
+	// s-a-b-t carries 2 at 3, s-b-t 2 at 3 and s-a-t 2 at 4.
+	CHECK(result.cost == 20);
+	auto const limited = gdwg::min_cost_flow(g, "s", "t", lane_terms, 3L);
+	CHECK(limited.flow == 3);
+	CHECK(limited.cost == 9);
+}
+
+TEST_CASE("Min Cost Flow - Edge Flows Follow Iteration Order") {
+	auto g = gdwg::graph<std::string, lane>{"s", "d", "c", "b", "a", "t"};
+	g.insert_edge("s", "a", lane{1, 5});
+	g.insert_edge("s", "b", lane{1, 5});
+	g.insert_edge("s", "c", lane{1, 5});
+	g.insert_edge("s", "d", lane{1, 5});
+	g.insert_edge("a", "t", lane{1, 2});
+	g.insert_edge("b", "t", lane{1, 3});
+	g.insert_edge("c", "t", lane{1, 4});
+	g.insert_edge("d", "t", lane{1, 1});
+	auto const result = gdwg::min_cost_flow(g, "s", "t", lane_terms);
+	CHECK(result.flow == 10);
+	REQUIRE(result.edge_flows.size() == g.edge_count());
+	// Every edge into t is saturated, and each edge out of s carries what its head passes on.
+	auto const into_t = std::map<std::string, long>{{"a", 2}, {"b", 3}, {"c", 4}, {"d", 1}};
+	auto edge = std::size_t{0};
+	for (auto const& [from, to, weight] : g) {
+		auto const flow = result.edge_flows[edge++];
+		CHECK(flow <= weight->capacity);
+		CHECK(flow == into_t.at(to == "t" ? from : to));
+	}
+}
+
+TEST_CASE("Min Cost Flow - Optimal On Random Networks") {
+	auto const min_cost = GENERATE(0L, -5L);
+	auto const edges = GENERATE(80, 300);
+	auto const g = random_lanes(static_cast<unsigned>(edges), 40, edges, min_cost);
+	auto const result = gdwg::min_cost_flow(g, 0, 39, lane_terms);
+	check_min_cost(g, *g.id_of(0), *g.id_of(39), result);
+
+	auto capacities = gdwg::graph<int, long>{};
+	for (auto v = 0; v < 40; ++v) {
+		capacities.insert_node(v);
+	}
+	for (auto const& [from, to, weight] : g) {
+		capacities.insert_edge(from, to, weight->capacity);
+	}
+	CHECK(result.flow == gdwg::max_flow(capacities, 0, 39).value);
+	auto const half = gdwg::min_cost_flow(g, 0, 39, lane_terms, result.flow / 2);
+	CHECK(half.flow == result.flow / 2);
+	check_min_cost(g, *g.id_of(0), *g.id_of(39), half);
+}
+
+TEST_CASE("Min Cost Flow - Errors") {
+	auto g = gdwg::graph<int, lane>{1, 2, 3};
+	g.insert_edge(1, 2, lane{-1, 1});
+	g.insert_edge(2, 3, lane{-1, 1});
+	g.insert_edge(3, 1, lane{-1, 1});
+	CHECK_THROWS_MATCHES(
+	    gdwg::min_cost_flow(g, 1, 3, lane_terms),
+	    std::runtime_error,
+	    Catch::Matchers::Message("Cannot call gdwg::min_cost_flow on a graph with a negative-cost cycle"));
+	CHECK_THROWS_MATCHES(
+	    gdwg::min_cost_flow(g, 1, 4, lane_terms),
+	    std::runtime_error,
+	    Catch::Matchers::Message("Cannot call gdwg::min_cost_flow if source or sink doesn't exist in the graph"));
+	CHECK_THROWS_MATCHES(gdwg::min_cost_flow(g, 2, 2, lane_terms),
+	                     std::runtime_error,
+	                     Catch::Matchers::Message("Cannot call gdwg::min_cost_flow with the same source and sink"));
+	g.insert_edge(1, 3, lane{0, -2});
+	CHECK_THROWS_MATCHES(
+	    gdwg::min_cost_flow(g, 1, 3, lane_terms),
+	    std::runtime_error,
+	    Catch::Matchers::Message("Cannot call gdwg::min_cost_flow on a graph with negative edge weights"));
+}
@@ -2,20 +2,89 @@
 #define GDWG_GRAPH_H
 
 #include <algorithm>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
 #include <iostream>
 #include <iterator>
+#include <limits>
 #include <map>
 #include <memory>
 #include <optional>
+#include <ranges>
 #include <set>
+#include <span>
 #include <sstream>
 #include <stdexcept>
 #include <string>
+#include <string_view>
 #include <tuple>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
 namespace gdwg {
+	namespace detail {
+		// Collects output in a local buffer and hands it to the stream in large blocks. Strings and
+		// integers are appended directly; anything else, or any stream with non-default formatting
+		// state, goes through the stream's own operator<<.
+		class buffered_writer {
+		 public:
+			explicit buffered_writer(std::ostream& os)
+			: os_{os}
+			, direct_{os.flags() == (std::ios_base::dec | std::ios_base::skipws) and os.width() == 0} {
+				buffer_.reserve(capacity);
+			}
+
+			template<typename T>
+			auto write(T const& value) -> void {
+				if constexpr (std::is_convertible_v<T const&, std::string_view>) {
+					if (direct_) {
+						append(std::string_view(value));
+						return;
+					}
+				}
+				else if constexpr (std::is_integral_v<T> and !std::is_same_v<T, bool> and !is_character<T>) {
+					if (direct_) {
+						char digits[std::numeric_limits<T>::digits10 + 3];
+						auto [last, ec] = std::to_chars(std::begin(digits), std::end(digits), value);
+						append(std::string_view(digits, static_cast<std::size_t>(last - digits)));
+						return;
+					}
+				}
+				flush();
+				os_ << value;
+			}
+
+			auto flush() -> void {
+				if (!buffer_.empty()) {
+					os_.write(buffer_.data(), static_cast<std::streamsize>(buffer_.size()));
+					buffer_.clear();
+				}
+			}
+
+		 private:
+			static constexpr auto capacity = std::size_t{1} << 16;
+
+			template<typename T>
+			static constexpr auto is_character = std::is_same_v<T, char> or std::is_same_v<T, signed char>
+			                                     or std::is_same_v<T, unsigned char> or std::is_same_v<T, wchar_t>
+			                                     or std::is_same_v<T, char8_t> or std::is_same_v<T, char16_t>
+			                                     or std::is_same_v<T, char32_t>;
+
+			auto append(std::string_view text) -> void {
+				if (buffer_.size() + text.size() > capacity) {
+					flush();
+				}
+				buffer_.append(text);
+			}
+
+			std::ostream& os_;
+			bool direct_;
+			std::string buffer_;
+		};
+	} // namespace detail
+
 	template<typename N, typename E>
 	class edge {
 	 public:
@@ -110,6 +179,77 @@ namespace gdwg {
 	class graph {
 	 public:
 		class iterator;
+		class connection_range;
+		// Nodes are interned: each value is stored once and everything else refers to it by a dense
+		// id in [0, node_count()). Erasing a node moves the highest id into the freed slot.
+		using node_id = std::uint32_t;
+
+		// An edge stored by value in its source's edge list. The source is implied by the list it
+		// belongs to, so only the destination id and the weight are kept per edge, along with the
+		// position of the edge's entry in its destination's in-edge list. Two records are equal
+		// when they describe the same edge, wherever their entries sit.
+		struct edge_record {
+			node_id dst;
+			std::uint32_t in_slot;
+			std::optional<E> weight;
+
+			auto operator==(edge_record const& other) const -> bool {
+				return dst == other.dst and weight == other.weight;
+			}
+		};
+
+	 private:
+		using node_map = std::map<N, node_id>;
+		using edge_list = std::vector<edge_record>;
+
+		// Lookup key for a single edge within a source's edge list.
+		struct edge_key {
+			N const& dst;
+			std::optional<E> const& weight;
+		};
+
+		// Orders a source's edges by destination value, then unweighted before weighted, then by
+		// weight, so that iterating an edge list visits edges in the documented order. Edges to the
+		// same destination are told apart by id alone. An edge_key finds one edge, a bare
+		// destination value finds the range of edges into it.
+		struct edge_less {
+			graph const* g;
+
+			auto operator()(edge_record const& lhs, edge_record const& rhs) const -> bool {
+				if (lhs.dst == rhs.dst) {
+					return lhs.weight < rhs.weight;
+				}
+				return g->node(lhs.dst) < g->node(rhs.dst);
+			}
+			auto operator()(edge_record const& lhs, edge_key const& rhs) const -> bool {
+				return compare(g->node(lhs.dst), lhs.weight, rhs.dst, rhs.weight);
+			}
+			auto operator()(edge_key const& lhs, edge_record const& rhs) const -> bool {
+				return compare(lhs.dst, lhs.weight, g->node(rhs.dst), rhs.weight);
+			}
+			auto operator()(edge_record const& lhs, N const& rhs) const -> bool {
+				return g->node(lhs.dst) < rhs;
+			}
+			auto operator()(N const& lhs, edge_record const& rhs) const -> bool {
+				return lhs < g->node(rhs.dst);
+			}
+
+		 private:
+			static auto compare(N const& lhs_dst,
+			                    std::optional<E> const& lhs_weight,
+			                    N const& rhs_dst,
+			                    std::optional<E> const& rhs_weight) -> bool {
+				if (lhs_dst < rhs_dst) {
+					return true;
+				}
+				if (rhs_dst < lhs_dst) {
+					return false;
+				}
+				return lhs_weight < rhs_weight;
+			}
+		};
+
+	 public:
 		// Constructors and Destructors
 		graph() = default;
 		~graph() = default;
@@ -132,7 +272,10 @@ namespace gdwg {
 		// Move Constructor
 		graph(graph&& other) noexcept
 		: nodes_(std::move(other.nodes_))
-		, adjacency_list_(std::move(other.adjacency_list_)) {
+		, id_to_node_(std::move(other.id_to_node_))
+		, out_edges_(std::move(other.out_edges_))
+		, in_edges_(std::move(other.in_edges_))
+		, edge_count_(other.edge_count_) {
 			other.clear();
 		}
 
@@ -140,7 +283,10 @@ namespace gdwg {
 		auto operator=(graph&& other) noexcept -> graph& {
 			if (this != &other) {
 				this->nodes_ = std::move(other.nodes_);
-				this->adjacency_list_ = std::move(other.adjacency_list_);
+				this->id_to_node_ = std::move(other.id_to_node_);
+				this->out_edges_ = std::move(other.out_edges_);
+				this->in_edges_ = std::move(other.in_edges_);
+				this->edge_count_ = other.edge_count_;
 				other.clear();
 			}
 			return *this;
@@ -149,23 +295,13 @@ namespace gdwg {
 		// Copy Constructor
 		graph(graph const& other)
 		: nodes_(other.nodes_)
-		, adjacency_list_() {
-			// iterate through and copy all the edges in the set, we cannot copy unique pointers
-			// has to be like a deep copy of edges.
-			for (auto const& [src, edges] : other.adjacency_list_) {
-				for (auto const& edge : edges) {
-					if (edge->is_weighted()) {
-						auto new_edge = std::make_unique<weighted_edge<N, E>>(edge->get_nodes().first,
-						                                                      edge->get_nodes().second,
-						                                                      *edge->get_weight());
-						adjacency_list_[src].emplace(std::move(new_edge));
-					}
-					else {
-						auto new_edge =
-						    std::make_unique<unweighted_edge<N, E>>(edge->get_nodes().first, edge->get_nodes().second);
-						adjacency_list_[src].emplace(std::move(new_edge));
-					}
-				}
+		, id_to_node_(other.id_to_node_.size())
+		, out_edges_(other.out_edges_)
+		, in_edges_(other.in_edges_)
+		, edge_count_(other.edge_count_) {
+			// ids carry over unchanged, only the id -> value table has to point into the new map.
+			for (auto it = nodes_.begin(); it != nodes_.end(); ++it) {
+				id_to_node_[it->second] = it;
 			}
 		}
 
@@ -179,38 +315,129 @@ namespace gdwg {
 
 		// Modifiers
 		auto insert_node(N const& value) -> bool {
-			return nodes_.insert(value).second;
+			if (nodes_.size() == max_nodes) {
+				throw std::length_error("Cannot call gdwg::graph<N, E>::insert_node when every node_id is in use");
+			}
+			auto [it, inserted] = nodes_.emplace(value, static_cast<node_id>(nodes_.size()));
+			if (inserted) {
+				id_to_node_.push_back(it);
+				out_edges_.emplace_back();
+				in_edges_.emplace_back();
+			}
+			return inserted;
 		};
 
 		auto insert_edge(N const& src, N const& dst, std::optional<E> weight = std::nullopt) -> bool {
-			if (!is_node(src) or !is_node(dst)) {
+			auto src_id = id_of(src);
+			auto dst_id = id_of(dst);
+			if (!src_id or !dst_id) {
 				throw std::runtime_error("Cannot call gdwg::graph<N, E>::insert_edge when either src or dst node does "
 				                         "not exist");
 			}
 
-			auto& edges = adjacency_list_[src];
-			auto it = std::find_if(edges.begin(), edges.end(), [&dst, &weight](auto const& edge) {
-				return edge->get_nodes().second == dst and edge->get_weight() == weight;
-			});
+			return emplace_edge(*src_id, *dst_id, weight);
+		};
 
-			if (it != edges.end()) {
-				return false;
+		// Inserts every node in range and returns how many were new. Storage for reserve_hint extra
+		// nodes is set aside up front, or for the whole range if it knows its size.
+		template<std::ranges::input_range R>
+		auto insert_nodes(R&& range, std::size_t reserve_hint = 0) -> std::size_t {
+			if constexpr (std::ranges::sized_range<R>) {
+				reserve_hint = std::max(reserve_hint, static_cast<std::size_t>(std::ranges::size(range)));
 			}
+			id_to_node_.reserve(nodes_.size() + reserve_hint);
+			out_edges_.reserve(nodes_.size() + reserve_hint);
+			in_edges_.reserve(nodes_.size() + reserve_hint);
+			auto inserted = std::size_t{0};
+			for (auto const& value : range) {
+				if (insert_node(value)) {
+					++inserted;
+				}
+			}
+			return inserted;
+		}
 
-			if (weight) {
-				auto new_edge = std::make_unique<weighted_edge<N, E>>(src, dst, *weight);
-				auto [it, inserted] = adjacency_list_[src].emplace(std::move(new_edge));
-				return inserted;
+		// Inserts every (src, dst, weight) in range and returns how many edges were new. Elements
+		// may be any tuple-like triple whose weight converts to std::optional<E>, including this
+		// graph's own iterator value type. The batch is sorted, deduplicated and merged into each
+		// source's edge list once, rather than inserted edge by edge. Nothing is inserted if any
+		// endpoint is missing.
+		template<std::ranges::input_range R>
+		auto insert_edges(R&& range) -> std::size_t {
+			auto batch = std::vector<std::pair<node_id, edge_record>>{};
+			if constexpr (std::ranges::sized_range<R>) {
+				batch.reserve(static_cast<std::size_t>(std::ranges::size(range)));
 			}
-			else {
-				auto new_edge = std::make_unique<unweighted_edge<N, E>>(src, dst);
-				auto [it, inserted] = adjacency_list_[src].emplace(std::move(new_edge));
-				return inserted;
+			// Consecutive edges usually share a source, so its id is looked up once per run.
+			auto src_it = nodes_.end();
+			for (auto const& [src, dst, weight] : range) {
+				if (src_it == nodes_.end() or src_it->first != src) {
+					src_it = nodes_.find(src);
+				}
+				auto dst_it = nodes_.find(dst);
+				if (src_it == nodes_.end() or dst_it == nodes_.end()) {
+					throw std::runtime_error("Cannot call gdwg::graph<N, E>::insert_edges when either src or dst node "
+					                         "does not exist");
+				}
+				batch.emplace_back(src_it->second, edge_record{dst_it->second, 0, std::optional<E>(weight)});
 			}
-		};
+
+			auto const batch_less = [less = edge_less{this}](auto const& lhs, auto const& rhs) {
+				return lhs.first != rhs.first ? lhs.first < rhs.first : less(lhs.second, rhs.second);
+			};
+			if (!std::is_sorted(batch.begin(), batch.end(), batch_less)) {
+				std::sort(batch.begin(), batch.end(), batch_less);
+			}
+			batch.erase(std::unique(batch.begin(), batch.end()), batch.end());
+
+			// (dst, src, position in src's edge list) for every new edge, so that each in-edge list
+			// is extended once at the end.
+			auto new_edges = std::vector<std::tuple<node_id, node_id, std::size_t>>{};
+			auto merged = edge_list{};
+			for (auto first = batch.begin(); first != batch.end();) {
+				auto const src = first->first;
+				auto const last = std::find_if(first, batch.end(), [src](auto const& e) { return e.first != src; });
+				auto& edges = out_edges_[src];
+				merged.clear();
+				merged.reserve(edges.size() + static_cast<std::size_t>(last - first));
+				auto edge_it = edges.begin();
+				for (; first != last; ++first) {
+					auto const& record = first->second;
+					while (edge_it != edges.end() and edge_less{this}(*edge_it, record)) {
+						merged.push_back(std::move(*edge_it++));
+					}
+					if (edge_it != edges.end() and *edge_it == record) {
+						continue;
+					}
+					new_edges.emplace_back(record.dst, src, merged.size());
+					merged.push_back(record);
+				}
+				std::move(edge_it, edges.end(), std::back_inserter(merged));
+				std::swap(edges, merged);
+			}
+
+			std::sort(new_edges.begin(), new_edges.end());
+			for (auto first = new_edges.begin(); first != new_edges.end();) {
+				auto const dst = std::get<0>(*first);
+				auto const last =
+				    std::find_if(first, new_edges.end(), [dst](auto const& e) { return std::get<0>(e) != dst; });
+				auto& sources = in_edges_[dst];
+				auto const size = sources.size() + static_cast<std::size_t>(last - first);
+				if (sources.capacity() < size) {
+					sources.reserve(std::max(size, 2 * sources.capacity()));
+				}
+				for (; first != last; ++first) {
+					auto const src = std::get<1>(*first);
+					out_edges_[src][std::get<2>(*first)].in_slot = link(src, dst);
+				}
+			}
+			edge_count_ += new_edges.size();
+			return new_edges.size();
+		}
 
 		auto replace_node(N const& old_data, N const& new_data) -> bool {
-			if (!is_node(old_data)) {
+			auto node_it = nodes_.find(old_data);
+			if (node_it == nodes_.end()) {
 				throw std::runtime_error("Cannot call gdwg::graph<N, E>::replace_node on a node that doesn't exist");
 			}
 
@@ -218,161 +445,119 @@ namespace gdwg {
 				return false;
 			}
 
-			nodes_.erase(old_data);
-			nodes_.insert(new_data);
-
-			auto new_adjacency_list = std::map<N, std::set<std::unique_ptr<edge<N, E>>>>{};
-			for (auto& [src, edges] : adjacency_list_) {
-				for (auto& e : edges) {
-					auto new_src = e->get_nodes().first == old_data ? new_data : e->get_nodes().first;
-					auto new_dst = e->get_nodes().second == old_data ? new_data : e->get_nodes().second;
-					if (e->is_weighted()) {
-						auto new_edge = std::make_unique<weighted_edge<N, E>>(new_src, new_dst, *e->get_weight());
-						new_adjacency_list[new_src].insert(std::move(new_edge));
-					}
-					else {
-						auto new_edge = std::make_unique<unweighted_edge<N, E>>(new_src, new_dst);
-						new_adjacency_list[new_src].insert(std::move(new_edge));
-					}
-				}
-				if (src == old_data) {
-					new_adjacency_list[new_data] = std::move(adjacency_list_[old_data]);
-				}
-				else {
-					new_adjacency_list[src] = std::move(edges);
-				}
+			// The node keeps its id, so only the value and the order of the edge lists that point
+			// at it change.
+			auto id = node_it->second;
+			auto handle = nodes_.extract(node_it);
+			handle.key() = new_data;
+			id_to_node_[id] = nodes_.insert(std::move(handle)).position;
+			auto sources = std::vector<node_id>(in_edges_[id].begin(), in_edges_[id].end());
+			std::sort(sources.begin(), sources.end());
+			sources.erase(std::unique(sources.begin(), sources.end()), sources.end());
+			for (auto const src : sources) {
+				reposition_destination(out_edges_[src], id);
 			}
-			adjacency_list_ = std::move(new_adjacency_list);
 
 			return true;
 		}
 
 		auto merge_replace_node(N const& old_data, N const& new_data) -> void {
-			if (!is_node(old_data) or !is_node(new_data)) {
+			auto old_id = id_of(old_data);
+			auto new_id = id_of(new_data);
+			if (!old_id or !new_id) {
 				throw std::runtime_error("Cannot call gdwg::graph<N, E>::merge_replace_node on old or new data if they "
 				                         "don't "
 				                         "exist "
 				                         "in the graph");
 			}
 
-			nodes_.erase(old_data);
+			if (*old_id == *new_id) {
+				return;
+			}
 
-			auto new_adjacency_list = std::map<N, std::set<std::unique_ptr<edge<N, E>>>>{};
-			for (auto& [src, edges] : adjacency_list_) {
-				for (auto& e : edges) {
-					auto new_src = e->get_nodes().first == old_data ? new_data : e->get_nodes().first;
-					auto new_dst = e->get_nodes().second == old_data ? new_data : e->get_nodes().second;
-					if (e->is_weighted()) {
-						auto new_edge = std::make_unique<weighted_edge<N, E>>(new_src, new_dst, *e->get_weight());
-						new_adjacency_list[new_src].insert(std::move(new_edge));
-					}
-					else {
-						auto new_edge = std::make_unique<unweighted_edge<N, E>>(new_src, new_dst);
-						new_adjacency_list[new_src].insert(std::move(new_edge));
-					}
-				}
-				if (src == old_data) {
-					new_adjacency_list[new_data] = std::move(adjacency_list_[old_data]);
-				}
-				else {
-					new_adjacency_list[src] = std::move(edges);
+			auto incident_edges = extract_incident_edges(*old_id);
+			auto moved = erase_id(*old_id);
+			// Edges of old_data now belong to new_data, and whichever node erase_id moved into
+			// old_data's slot is now known by that id.
+			auto const remap = [old = *old_id, moved, target = *new_id == moved ? *old_id : *new_id](node_id id) {
+				if (id == old) {
+					return target;
 				}
+				return id == moved ? old : id;
+			};
+			for (auto const& [src, dst, weight] : incident_edges) {
+				emplace_edge(remap(src), remap(dst), weight);
 			}
-			adjacency_list_ = std::move(new_adjacency_list);
 		}
 
 		auto erase_node(N const& value) -> bool {
-			if (!is_node(value)) {
+			auto id = id_of(value);
+			if (!id) {
 				return false;
 			}
 
-			nodes_.erase(value);
-
-			auto new_adjacency_list = std::map<N, std::set<std::unique_ptr<edge<N, E>>>>{};
-			for (auto& [src, edges] : adjacency_list_) {
-				if (src == value) {
-					continue;
-				}
-
-				auto new_edges = std::set<std::unique_ptr<edge<N, E>>>{};
-				for (auto& e : edges) {
-					if (e->get_nodes().second != value) {
-						if (e->is_weighted()) {
-							new_edges.insert(std::make_unique<weighted_edge<N, E>>(e->get_nodes().first,
-							                                                       e->get_nodes().second,
-							                                                       *e->get_weight()));
-						}
-						else {
-							new_edges.insert(
-							    std::make_unique<unweighted_edge<N, E>>(e->get_nodes().first, e->get_nodes().second));
-						}
-					}
-				}
-				new_adjacency_list[src] = std::move(new_edges);
-			}
-			adjacency_list_ = std::move(new_adjacency_list);
+			extract_incident_edges(*id);
+			erase_id(*id);
 
 			return true;
 		}
 
 		auto erase_edge(N const& src, N const& dst, std::optional<E> weight = std::nullopt) -> bool {
-			if (!is_node(src) or !is_node(dst)) {
+			auto src_id = id_of(src);
+			auto dst_id = id_of(dst);
+			if (!src_id or !dst_id) {
 				throw std::runtime_error("Cannot call gdwg::graph<N, E>::erase_edge on src or dst if they don't exist "
 				                         "in the "
 				                         "graph");
 			}
 
-			auto new_adjacency_list = std::map<N, std::set<std::unique_ptr<edge<N, E>>>>{};
-			auto edge_removed = false;
-			for (auto& [current_src, edges] : adjacency_list_) {
-				auto new_edges = std::set<std::unique_ptr<edge<N, E>>>{};
-				for (auto& e : edges) {
-					if (current_src == src and e->get_nodes().second == dst and e->get_weight() == weight) {
-						edge_removed = true;
-						continue;
-					}
-					if (e->is_weighted()) {
-						new_edges.insert(std::make_unique<weighted_edge<N, E>>(e->get_nodes().first,
-						                                                       e->get_nodes().second,
-						                                                       *e->get_weight()));
-					}
-					else {
-						new_edges.insert(
-						    std::make_unique<unweighted_edge<N, E>>(e->get_nodes().first, e->get_nodes().second));
-					}
-				}
-				if (!new_edges.empty()) {
-					new_adjacency_list[current_src] = std::move(new_edges);
-				}
+			// The destination's in-edge entry is swapped out in O(1), so the cost is bounded by the
+			// source's out-degree.
+			auto& edges = out_edges_[*src_id];
+			auto edge_it = find_edge(edges, dst, weight);
+			if (edge_it == edges.end()) {
+				return false;
 			}
-
-			adjacency_list_ = std::move(new_adjacency_list);
-			return edge_removed;
+			unlink(*edge_it);
+			edges.erase(edge_it);
+			return true;
 		}
 
 		auto erase_edge(iterator i) -> iterator {
-			auto [src, dst, weight] = *i;
-			erase_edge(src, dst, weight);
-			++i;
-			if (i == end()) {
-				return end();
-			}
-			return i;
+			auto s = i;
+			++s;
+			return erase_edge(i, s);
 		}
 
 		auto erase_edge(iterator i, iterator s) -> iterator {
-			while (i != s) {
-				i = erase_edge(i);
+			// Erases [i, s) one source at a time with a single block erase per edge list. Each edge's
+			// in-edge entry is swapped out in O(1), so each edge costs amortised O(1).
+			auto node_it = i.node_it_;
+			auto edge_it = i.edge_it_;
+			while (node_it != s.node_it_) {
+				auto& edges = out_edges_[node_it->second];
+				unlink_range(edge_it, edges.cend());
+				edges.erase(edge_it, edges.cend());
+				node_it = first_with_edges(std::next(node_it));
+				if (node_it != nodes_.end()) {
+					edge_it = out_edges_[node_it->second].cbegin();
+				}
 			}
-			if (i == end()) {
+			if (node_it == nodes_.end()) {
 				return end();
 			}
-			return s;
+			// Erasing shifts the rest of this edge list down, so s is re-derived from the erase position.
+			auto& edges = out_edges_[node_it->second];
+			unlink_range(edge_it, s.edge_it_);
+			return iterator(this, node_it, edges.erase(edge_it, s.edge_it_));
 		}
 
 		auto clear() noexcept -> void {
 			nodes_.clear();
-			adjacency_list_.clear();
+			id_to_node_.clear();
+			out_edges_.clear();
+			in_edges_.clear();
+			edge_count_ = 0;
 		}
 
 		// Accessors
@@ -385,220 +570,194 @@ namespace gdwg {
 		}
 
 		[[nodiscard]] auto is_connected(N const& src, N const& dst) const -> bool {
-			if (!is_node(src) or !is_node(dst)) {
+			auto src_id = id_of(src);
+			if (!src_id or !is_node(dst)) {
 				throw std::runtime_error("Cannot call gdwg::graph<N, E>::is_connected if src or dst node don't exist "
 				                         "in the "
 				                         "graph");
 			}
-			auto const& edges = adjacency_list_.at(src);
-			return std::any_of(edges.begin(), edges.end(), [&dst](auto const& edge) {
-				return edge->get_nodes().second == dst;
-			});
+			auto const& edges = out_edges_[*src_id];
+			return std::binary_search(edges.begin(), edges.end(), dst, edge_less{this});
 		}
 
 		[[nodiscard]] auto nodes() const -> std::vector<N> {
 			auto result = std::vector<N>{};
 			result.reserve(nodes_.size()); // Reserve space to avoid multiple allocations
-			for (auto const& node : nodes_) {
+			for (auto const& [node, id] : nodes_) {
 				result.push_back(node);
 			}
-			std::sort(result.begin(), result.end());
 			return result;
 		}
 
 		[[nodiscard]] auto edges(N const& src, N const& dst) const -> std::vector<std::unique_ptr<edge<N, E>>> {
-			if (!is_node(src) or !is_node(dst)) {
+			auto src_id = id_of(src);
+			if (!src_id or !is_node(dst)) {
 				throw std::runtime_error("Cannot call gdwg::graph<N, E>::edges if src or dst node don't exist in the "
 				                         "graph");
 			}
 			auto result = std::vector<std::unique_ptr<edge<N, E>>>{};
-			auto unweighted_edges = std::vector<std::unique_ptr<unweighted_edge<N, E>>>{};
-			auto weighted_edges = std::vector<std::unique_ptr<weighted_edge<N, E>>>{};
-
-			auto const& edges = adjacency_list_.at(src);
-			for (auto& e : edges) {
-				if (e->is_weighted()) {
-					weighted_edges.push_back(std::make_unique<weighted_edge<N, E>>(e->get_nodes().first,
-					                                                               e->get_nodes().second,
-					                                                               *e->get_weight()));
+			// The unweighted edge, if any, sorts first and the weighted ones follow in ascending order.
+			// This is the only place edge objects are created; the graph itself stores plain records.
+			auto const& edges = out_edges_[*src_id];
+			auto [first, last] = std::equal_range(edges.begin(), edges.end(), dst, edge_less{this});
+			for (; first != last; ++first) {
+				if (first->weight) {
+					result.push_back(std::make_unique<weighted_edge<N, E>>(src, dst, *first->weight));
 				}
 				else {
-					unweighted_edges.push_back(
-					    std::make_unique<unweighted_edge<N, E>>(e->get_nodes().first, e->get_nodes().second));
-				}
-			}
-			if (unweighted_edges.size() != 0) {
-				for (auto& e : unweighted_edges) {
-					result.push_back(std::move(e));
+					result.push_back(std::make_unique<unweighted_edge<N, E>>(src, dst));
 				}
 			}
-
-			std::sort(weighted_edges.begin(), weighted_edges.end(), [](auto const& a, auto const& b) {
-				return a->get_weight() < b->get_weight();
-			});
-
-			for (auto& e : weighted_edges) {
-				result.push_back(std::move(e));
-			}
 			return result;
 		}
 
 		[[nodiscard]] auto find(N const& src, N const& dst, std::optional<E> weight = std::nullopt) const -> iterator {
-			auto const& node_it = adjacency_list_.find(src);
-			if (node_it == adjacency_list_.end()) {
+			auto node_it = nodes_.find(src);
+			if (node_it == nodes_.end()) {
 				return end();
 			}
-			auto edge_it = std::find_if(node_it->second.begin(), node_it->second.end(), [&dst, &weight](auto const& e) {
-				if (weight.has_value()) {
-					return e->get_nodes().second == dst and e->get_weight() == weight;
-				}
-				else {
-					return e->get_nodes().second == dst and !e->get_weight().has_value();
-				}
-			});
-			return edge_it != node_it->second.end() ? iterator(node_it, adjacency_list_.end(), edge_it) : end();
+			auto const& edges = out_edges_[node_it->second];
+			auto edge_it = find_edge(edges, dst, weight);
+			return edge_it != edges.end() ? iterator(this, node_it, edge_it) : end();
 		}
 
 		[[nodiscard]] auto connections(N const& src) const -> std::vector<N> {
-			if (!is_node(src)) {
+			auto src_id = id_of(src);
+			if (!src_id) {
 				throw std::runtime_error("Cannot call gdwg::graph<N, E>::connections if src doesn't exist in the "
 				                         "graph");
 			}
-			auto& edges = adjacency_list_.at(src);
-			auto connections = std::set<N>{};
-			for (auto& e : edges) {
-				connections.insert(e->get_nodes().second);
+			auto connections = std::vector<N>{};
+			auto previous = std::optional<node_id>{};
+			// Edges are grouped by destination, so each new destination is a new connection.
+			for (auto const& e : out_edges_[*src_id]) {
+				if (previous != e.dst) {
+					connections.push_back(node(e.dst));
+					previous = e.dst;
+				}
 			}
-			return std::vector<N>(connections.begin(), connections.end());
+			return connections;
 		}
 
-		// Iterator Access
-		[[nodiscard]] auto begin() const -> iterator {
-			auto node_it = adjacency_list_.begin();
-			while (node_it != adjacency_list_.end() and node_it->second.empty()) {
-				++node_it;
+		// Views over the stored edges that allocate nothing. They are invalidated by any modifier.
+
+		// The edges src -> dst, unweighted first and then by ascending weight.
+		[[nodiscard]] auto edges_view(N const& src, N const& dst) const -> std::span<edge_record const> {
+			auto src_id = id_of(src);
+			if (!src_id or !is_node(dst)) {
+				throw std::runtime_error("Cannot call gdwg::graph<N, E>::edges_view if src or dst node don't exist in "
+				                         "the graph");
 			}
-			if (node_it == adjacency_list_.end()) {
-				return end();
+			auto const& edges = out_edges_[*src_id];
+			auto [first, last] = std::equal_range(edges.begin(), edges.end(), dst, edge_less{this});
+			return std::span<edge_record const>(first, last);
+		}
+
+		// The distinct destinations of src's outgoing edges in ascending order.
+		[[nodiscard]] auto connections_view(N const& src) const -> connection_range {
+			auto src_id = id_of(src);
+			if (!src_id) {
+				throw std::runtime_error("Cannot call gdwg::graph<N, E>::connections_view if src doesn't exist in the "
+				                         "graph");
 			}
-			return iterator(node_it, adjacency_list_.end(), node_it->second.begin());
+			return connection_range(this, out_edges_[*src_id]);
 		}
 
-		[[nodiscard]] auto end() const -> iterator {
-			auto node_it = adjacency_list_.begin();
-			while (node_it != adjacency_list_.end() and node_it->second.empty()) {
-				++node_it;
+		// Dense Access
+		[[nodiscard]] auto node_count() const noexcept -> std::size_t {
+			return nodes_.size();
+		}
+
+		[[nodiscard]] auto edge_count() const noexcept -> std::size_t {
+			return edge_count_;
+		}
+
+		[[nodiscard]] auto id_of(N const& value) const -> std::optional<node_id> {
+			auto it = nodes_.find(value);
+			if (it == nodes_.end()) {
+				return std::nullopt;
 			}
-			if (node_it == adjacency_list_.end()) {
+			return it->second;
+		}
+
+		[[nodiscard]] auto node(node_id id) const -> N const& {
+			return id_to_node_[id]->first;
+		}
+
+		// Outgoing edges of id, ordered by destination value and then weight.
+		[[nodiscard]] auto out_edges(node_id id) const -> std::span<edge_record const> {
+			return out_edges_[id];
+		}
+
+		// Sources of the edges into id, repeated once per parallel edge, in no particular order.
+		[[nodiscard]] auto in_edges(node_id id) const -> std::span<node_id const> {
+			return in_edges_[id];
+		}
+
+		// Iterator Access
+		[[nodiscard]] auto begin() const -> iterator {
+			auto node_it = first_with_edges(nodes_.begin());
+			if (node_it == nodes_.end()) {
 				return end();
 			}
-			return iterator(node_it, adjacency_list_.end(), node_it->second.end());
+			return iterator(this, node_it, out_edges_[node_it->second].begin());
+		}
+
+		[[nodiscard]] auto end() const -> iterator {
+			return iterator(this, nodes_.end(), {});
 		}
 
 		// Comparisons
 		[[nodiscard]] auto operator==(graph const& other) const -> bool {
 			// Check if the sets of nodes are the same
-			if (nodes_ != other.nodes_) {
-				return false;
-			}
-
-			// Check if the adjacency lists have the same structure
-			if (adjacency_list_.size() != other.adjacency_list_.size()) {
+			if (nodes_.size() != other.nodes_.size() or edge_count_ != other.edge_count_) {
 				return false;
 			}
 
-			for (auto const& [src, edges] : adjacency_list_) {
-				if (!other.is_node(src)) {
-					return false;
-				}
-				auto const& other_edges = other.adjacency_list_.at(src);
-				if (edges.size() != other_edges.size()) {
-					return false;
-				}
-
-				// Convert the sets of edges to vectors for sorting and comparison
-				std::vector<edge<N, E>*> edges_vector;
-				for (auto const& edge : edges) {
-					edges_vector.push_back(edge.get());
-				}
-
-				std::vector<edge<N, E>*> other_edges_vector;
-				for (auto const& edge : other_edges) {
-					other_edges_vector.push_back(edge.get());
-				}
-
-				// Sort the vectors
-				auto edge_comparator = [](const edge<N, E>* lhs, const edge<N, E>* rhs) {
-					if (lhs->get_nodes().second != rhs->get_nodes().second) {
-						return lhs->get_nodes().second < rhs->get_nodes().second;
-					}
-					if (lhs->is_weighted() and rhs->is_weighted()) {
-						return lhs->get_weight() < rhs->get_weight();
-					}
-					if (!lhs->is_weighted() and !rhs->is_weighted()) {
-						return false;
-					}
-					return lhs->is_weighted() < rhs->is_weighted();
-				};
-				std::sort(edges_vector.begin(), edges_vector.end(), edge_comparator);
-				std::sort(other_edges_vector.begin(), other_edges_vector.end(), edge_comparator);
-
-				// Compare the sorted vectors
-				for (size_t i = 0; i < edges_vector.size(); ++i) {
-					if (!(edges_vector[i]->get_nodes() == other_edges_vector[i]->get_nodes()
-					      and edges_vector[i]->get_weight() == other_edges_vector[i]->get_weight()))
-					{
-						return false;
-					}
-				}
-			}
-			return true;
+			// Ids differ between graphs, but both keep each edge list in value order, so the lists of
+			// matching nodes compare element-wise once destinations are mapped back to values.
+			auto const same_edge = [this, &other](edge_record const& lhs, edge_record const& rhs) {
+				return lhs.weight == rhs.weight and node(lhs.dst) == other.node(rhs.dst);
+			};
+			return std::equal(nodes_.begin(),
+			                  nodes_.end(),
+			                  other.nodes_.begin(),
+			                  [this, &other, &same_edge](auto const& lhs, auto const& rhs) {
+				                  auto const& lhs_edges = out_edges_[lhs.second];
+				                  auto const& rhs_edges = other.out_edges_[rhs.second];
+				                  return lhs.first == rhs.first
+				                         and std::equal(lhs_edges.begin(),
+				                                        lhs_edges.end(),
+				                                        rhs_edges.begin(),
+				                                        rhs_edges.end(),
+				                                        same_edge);
+			                  });
 		}
 
 		// Extractor
 		friend auto operator<<(std::ostream& os, graph const& g) -> std::ostream& {
-			if (g.empty()) {
-				os << "";
-				return os;
-			}
-			std::vector<std::tuple<N, N, std::optional<E>>> edges;
-
-			for (auto const& [src, edge_set] : g.adjacency_list_) {
-				for (auto const& edge : edge_set) {
-					edges.emplace_back(src, edge->get_nodes().second, edge->get_weight());
-				}
-			}
-
-			// Sort the edges by src, dst, and weight
-			std::sort(edges.begin(), edges.end(), [](auto const& a, auto const& b) {
-				if (std::get<0>(a) != std::get<0>(b)) {
-					return std::get<0>(a) < std::get<0>(b);
-				}
-				if (std::get<1>(a) != std::get<1>(b)) {
-					return std::get<1>(a) < std::get<1>(b);
-				}
-				if (std::get<2>(a).has_value() and std::get<2>(b).has_value()) {
-					return std::get<2>(a).value() < std::get<2>(b).value();
-				}
-				return std::get<2>(a).has_value() ? false : true;
-			});
-
-			for (auto const& node : g.nodes_) {
-				os << node << " (\n";
-
-				for (auto const& edge : edges) {
-					if (std::get<0>(edge) == node) {
-						os << "  " << std::get<0>(edge) << " -> " << std::get<1>(edge) << " | ";
-						if (std::get<2>(edge).has_value()) {
-							os << "W | " << std::get<2>(edge).value() << "\n";
-						}
-						else {
-							os << "U\n";
-						}
+			// Nodes and each node's edge list are already in output order, so this is a single pass.
+			auto out = detail::buffered_writer(os);
+			for (auto const& [node, id] : g.nodes_) {
+				out.write(node);
+				out.write(" (\n");
+				for (auto const& edge : g.out_edges_[id]) {
+					out.write("  ");
+					out.write(node);
+					out.write(" -> ");
+					out.write(g.node(edge.dst));
+					if (edge.weight.has_value()) {
+						out.write(" | W | ");
+						out.write(*edge.weight);
+						out.write("\n");
+					}
+					else {
+						out.write(" | U\n");
 					}
 				}
-				os << ")\n";
+				out.write(")\n");
 			}
+			out.flush();
 			return os;
 		};
 
@@ -613,38 +772,33 @@ namespace gdwg {
 			using pointer = void;
 			using difference_type = std::ptrdiff_t;
 			using iterator_category = std::bidirectional_iterator_tag;
-			using node_iterator = std::map<N, std::set<std::unique_ptr<edge<N, E>>>>::const_iterator;
-			using edge_iterator = std::set<std::unique_ptr<edge<N, E>>>::const_iterator;
+			using node_iterator = typename node_map::const_iterator;
+			using edge_iterator = typename edge_list::const_iterator;
 
 			// Constructors and Destructors
 			iterator()
-			: current_node_it_{}
-			, end_node_it_{}
+			: graph_{nullptr}
+			, node_it_{}
 			, edge_it_{} {}
 			~iterator() = default;
 
-			explicit iterator(node_iterator current_node_it, node_iterator end_node_it, edge_iterator edge_it)
-			: current_node_it_{current_node_it}
-			, end_node_it_{end_node_it}
-			, edge_it_{edge_it} {
-				if (current_node_it_ != end_node_it_) {
-					edge_it_ = current_node_it_->second.begin();
-				}
-			}
+			explicit iterator(graph const* g, node_iterator node_it, edge_iterator edge_it)
+			: graph_{g}
+			, node_it_{node_it}
+			, edge_it_{edge_it} {}
 
 			// Iterator Source
 			auto operator*() const -> reference {
-				return {current_node_it_->first, (*edge_it_)->get_nodes().second, (*edge_it_)->get_weight()};
+				return {node_it_->first, graph_->node(edge_it_->dst), edge_it_->weight};
 			}
 
 			// Iterator Traversal (Pre Increment)
 			auto operator++() -> iterator& {
 				++edge_it_;
-				while (current_node_it_ != end_node_it_ and edge_it_ == current_node_it_->second.end()) {
-					++current_node_it_;
-					if (current_node_it_ != end_node_it_) {
-						edge_it_ = current_node_it_->second.begin();
-					}
+				if (edge_it_ == graph_->out_edges_[node_it_->second].end()) {
+					node_it_ = graph_->first_with_edges(std::next(node_it_));
+					edge_it_ = node_it_ == graph_->nodes_.end() ? edge_iterator{}
+					                                            : graph_->out_edges_[node_it_->second].begin();
 				}
 				return *this;
 			}
@@ -658,16 +812,11 @@ namespace gdwg {
 
 			// Pre Decrement
 			auto operator--() -> iterator& {
-				if (edge_it_ == current_node_it_->second.begin()) {
-					if (current_node_it_ != end_node_it_) {
-						while (current_node_it_ != end_node_it_) {
-							--current_node_it_;
-							if (!current_node_it_->second.empty()) {
-								edge_it_ = current_node_it_->second.end();
-								break;
-							}
-						}
-					}
+				if (node_it_ == graph_->nodes_.end() or edge_it_ == graph_->out_edges_[node_it_->second].begin()) {
+					do {
+						--node_it_;
+					} while (graph_->out_edges_[node_it_->second].empty());
+					edge_it_ = graph_->out_edges_[node_it_->second].end();
 				}
 				--edge_it_;
 				return *this;
@@ -682,20 +831,258 @@ namespace gdwg {
 
 			// Iterator Comparisons
 			auto operator==(iterator const& other) const noexcept -> bool {
-				return current_node_it_ == other.current_node_it_
-				       and (current_node_it_ == end_node_it_ or edge_it_ == other.edge_it_);
+				return node_it_ == other.node_it_
+				       and (graph_ == nullptr or node_it_ == graph_->nodes_.end() or edge_it_ == other.edge_it_);
 			}
 
 		 private:
-			node_iterator current_node_it_;
-			node_iterator end_node_it_;
+			friend class graph;
+
+			graph const* graph_;
+			node_iterator node_it_;
 			edge_iterator edge_it_;
 		};
 
+		class connection_range {
+		 public:
+			class iterator {
+			 public:
+				using value_type = N;
+				using reference = N const&;
+				using pointer = N const*;
+				using difference_type = std::ptrdiff_t;
+				using iterator_category = std::forward_iterator_tag;
+
+				iterator() = default;
+
+				auto operator*() const -> reference {
+					return graph_->node(edge_->dst);
+				}
+
+				// Skips the rest of the parallel edges to the current destination.
+				auto operator++() -> iterator& {
+					auto const dst = edge_->dst;
+					do {
+						++edge_;
+					} while (edge_ != last_ and edge_->dst == dst);
+					return *this;
+				}
+
+				auto operator++(int) -> iterator {
+					auto temp = *this;
+					++*this;
+					return temp;
+				}
+
+				auto operator==(iterator const& other) const noexcept -> bool {
+					return edge_ == other.edge_;
+				}
+
+			 private:
+				friend class connection_range;
+
+				explicit iterator(graph const* g, edge_record const* edge, edge_record const* last)
+				: graph_{g}
+				, edge_{edge}
+				, last_{last} {}
+
+				graph const* graph_ = nullptr;
+				edge_record const* edge_ = nullptr;
+				edge_record const* last_ = nullptr;
+			};
+
+			connection_range() = default;
+
+			[[nodiscard]] auto begin() const -> iterator {
+				return iterator(graph_, edges_.data(), edges_.data() + edges_.size());
+			}
+
+			[[nodiscard]] auto end() const -> iterator {
+				auto const last = edges_.data() + edges_.size();
+				return iterator(graph_, last, last);
+			}
+
+			[[nodiscard]] auto empty() const noexcept -> bool {
+				return edges_.empty();
+			}
+
+		 private:
+			friend class graph;
+
+			explicit connection_range(graph const* g, std::span<edge_record const> edges)
+			: graph_{g}
+			, edges_{edges} {}
+
+			graph const* graph_ = nullptr;
+			std::span<edge_record const> edges_;
+		};
+
 	 private:
-		std::set<N> nodes_;
-		std::map<N, std::set<std::unique_ptr<edge<N, E>>>> adjacency_list_;
+		static constexpr auto max_nodes = std::size_t{std::numeric_limits<node_id>::max()};
+
+		// Adds src -> dst without checking that both nodes exist.
+		auto emplace_edge(node_id src, node_id dst, std::optional<E> const& weight) -> bool {
+			auto& edges = out_edges_[src];
+			auto it = std::lower_bound(edges.begin(), edges.end(), edge_record{dst, 0, weight}, edge_less{this});
+			if (it != edges.end() and it->dst == dst and it->weight == weight) {
+				return false;
+			}
+
+			edges.insert(it, edge_record{dst, link(src, dst), weight});
+			++edge_count_;
+			return true;
+		}
+
+		auto find_edge(edge_list const& edges, N const& dst, std::optional<E> const& weight) const ->
+		    typename edge_list::const_iterator {
+			auto it = std::lower_bound(edges.begin(), edges.end(), edge_key{dst, weight}, edge_less{this});
+			if (it != edges.end() and node(it->dst) == dst and it->weight == weight) {
+				return it;
+			}
+			return edges.end();
+		}
+
+		auto first_with_edges(typename node_map::const_iterator node_it) const -> typename node_map::const_iterator {
+			while (node_it != nodes_.end() and out_edges_[node_it->second].empty()) {
+				++node_it;
+			}
+			return node_it;
+		}
+
+		// Appends src to dst's in-edge list and returns the slot it was given.
+		auto link(node_id src, node_id dst) -> std::uint32_t {
+			auto& sources = in_edges_[dst];
+			sources.push_back(src);
+			return static_cast<std::uint32_t>(sources.size() - 1);
+		}
+
+		// Drops record's entry from its destination's in-edge list by moving the list's last entry
+		// into its slot. The edge that entry belongs to is one of its source's edges into the same
+		// destination, so finding it to update its slot costs a binary search and no allocation.
+		auto unlink(edge_record const& record) -> void {
+			auto& sources = in_edges_[record.dst];
+			auto const last = static_cast<std::uint32_t>(sources.size() - 1);
+			if (record.in_slot != last) {
+				auto const moved = sources[last];
+				sources[record.in_slot] = moved;
+				auto& edges = out_edges_[moved];
+				auto [first, end] = std::equal_range(edges.begin(), edges.end(), node(record.dst), edge_less{this});
+				std::find_if(first, end, [last](edge_record const& e) { return e.in_slot == last; })->in_slot =
+				    record.in_slot;
+			}
+			sources.pop_back();
+			--edge_count_;
+		}
+
+		auto unlink_range(typename edge_list::const_iterator first, typename edge_list::const_iterator last) -> void {
+			for (; first != last; ++first) {
+				unlink(*first);
+			}
+		}
+
+		// Moves the block of edges into dst back into value order after dst's value has changed.
+		// The block is still contiguous and the rest of the list is still sorted, so one rotate
+		// suffices.
+		auto reposition_destination(edge_list& edges, node_id dst) -> void {
+			auto const is_dst = [dst](edge_record const& e) { return e.dst == dst; };
+			auto first = std::find_if(edges.begin(), edges.end(), is_dst);
+			auto last = std::find_if_not(first, edges.end(), is_dst);
+			auto const& value = node(dst);
+			auto before = std::lower_bound(edges.begin(), first, value, edge_less{this});
+			if (before != first) {
+				std::rotate(before, first, last);
+				return;
+			}
+			auto after = std::lower_bound(last, edges.end(), value, edge_less{this});
+			std::rotate(first, last, after);
+		}
+
+		// Removes every edge into or out of id and returns them as (src, dst, weight). Only the
+		// edge lists of id's in-neighbours and the in-edge lists of its out-neighbours are touched.
+		auto extract_incident_edges(node_id id) -> std::vector<std::tuple<node_id, node_id, std::optional<E>>> {
+			auto result = std::vector<std::tuple<node_id, node_id, std::optional<E>>>{};
+			for (auto const& e : out_edges_[id]) {
+				result.emplace_back(id, e.dst, e.weight);
+				if (e.dst != id) {
+					unlink(e);
+				}
+			}
+			// A source with parallel edges into id appears more than once, but its first visit
+			// erases them all and later visits find nothing.
+			for (auto const src : in_edges_[id]) {
+				if (src == id) {
+					continue;
+				}
+				auto& edges = out_edges_[src];
+				auto [first, last] = std::equal_range(edges.begin(), edges.end(), node(id), edge_less{this});
+				for (auto edge_it = first; edge_it != last; ++edge_it) {
+					result.emplace_back(src, id, edge_it->weight);
+				}
+				edge_count_ -= static_cast<std::size_t>(last - first);
+				edges.erase(first, last);
+			}
+			// Self loops were counted with the outgoing edges and are dropped along with them.
+			auto const& sources = in_edges_[id];
+			edge_count_ -= static_cast<std::size_t>(std::count(sources.begin(), sources.end(), id));
+			out_edges_[id].clear();
+			in_edges_[id].clear();
+			return result;
+		}
+
+		// Removes an isolated node and keeps ids dense by moving the highest id into its slot.
+		// Returns the id that was moved, which now refers to the node formerly at that id.
+		auto erase_id(node_id id) -> node_id {
+			auto const last = static_cast<node_id>(nodes_.size() - 1);
+			nodes_.erase(id_to_node_[id]);
+			if (id != last) {
+				id_to_node_[id] = id_to_node_[last];
+				id_to_node_[id]->second = id;
+				out_edges_[id] = std::move(out_edges_[last]);
+				in_edges_[id] = std::move(in_edges_[last]);
+
+				auto& sources = in_edges_[id];
+				std::replace(sources.begin(), sources.end(), last, id);
+				for (auto const src : sources) {
+					auto& edges = out_edges_[src];
+					auto [first, end] = std::equal_range(edges.begin(), edges.end(), node(id), edge_less{this});
+					for (; first != end; ++first) {
+						first->dst = id;
+					}
+				}
+				// Each outgoing edge knows where its entry sits, so renaming the entries is O(1) each.
+				for (auto const& e : out_edges_[id]) {
+					in_edges_[e.dst][e.in_slot] = id;
+				}
+			}
+			id_to_node_.pop_back();
+			out_edges_.pop_back();
+			in_edges_.pop_back();
+			return last;
+		}
+
+		node_map nodes_;
+		// id -> position of the node's value in nodes_, so each value is stored exactly once.
+		std::vector<typename node_map::iterator> id_to_node_;
+		// id -> outgoing edges, ordered by destination value and then weight.
+		std::vector<edge_list> out_edges_;
+		// id -> sources of incoming edges, unordered, one entry per edge. Each edge_record holds the
+		// position of its own entry, so an entry is removed in O(1) by swapping in the last one.
+		std::vector<std::vector<node_id>> in_edges_;
+		std::size_t edge_count_ = 0;
 	};
+
+	namespace detail {
+		// The dense id of value, for algorithms that take their endpoints by value.
+		template<typename N, typename E>
+		auto id_or_throw(graph<N, E> const& g, N const& value, char const* message) ->
+		    typename graph<N, E>::node_id {
+			auto id = g.id_of(value);
+			if (!id) {
+				throw std::runtime_error(message);
+			}
+			return *id;
+		}
+	} // namespace detail
 } // namespace gdwg
 
 #endif // GDWG_GRAPH_H
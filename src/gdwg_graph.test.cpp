@@ -2,6 +2,11 @@
 
 #include <catch2/catch.hpp>
 
+#include <random>
+#include <ranges>
+#include <set>
+#include <tuple>
+
 TEST_CASE("basic test") {
 	auto g = gdwg::graph<int, std::string>{};
 	auto n = 5;
@@ -58,6 +63,17 @@ TEST_CASE("Graph Constructors - copy and move") {
 	CHECK(g1.empty());
 }
 
+TEST_CASE("Graph Constructors - copy is independent") {
+	auto g1 = gdwg::graph<std::string, int>{"a", "b"};
+	CHECK(g1.insert_edge("a", "b", 1));
+	auto g2 = g1;
+	CHECK(g2.insert_edge("b", "a"));
+	CHECK(g2.erase_edge("a", "b", 1));
+	CHECK(g1.is_connected("a", "b"));
+	REQUIRE_FALSE(g1.is_connected("b", "a"));
+	REQUIRE_FALSE(g1 == g2);
+}
+
 TEST_CASE("Weighted Edge - Constructor") {}
 
 TEST_CASE("Weighted Edge - Print Edge") {
@@ -221,6 +237,64 @@ TEST_CASE("Erase Node") {
 	REQUIRE_FALSE(g.is_node(3));
 }
 
+TEST_CASE("Replace Node - Incoming Edges and Self Loops") {
+	auto g = gdwg::graph<std::string, int>{"A", "B", "C"};
+	CHECK(g.insert_edge("A", "B", 1));
+	CHECK(g.insert_edge("B", "A", 2));
+	CHECK(g.insert_edge("C", "A"));
+	CHECK(g.insert_edge("A", "A", 3));
+
+	CHECK(g.replace_node("A", "D"));
+	REQUIRE_FALSE(g.replace_node("B", "C"));
+	CHECK(g.find("D", "B", 1) != g.end());
+	CHECK(g.find("B", "D", 2) != g.end());
+	CHECK(g.find("C", "D") != g.end());
+	CHECK(g.find("D", "D", 3) != g.end());
+	CHECK(g.connections("B") == std::vector<std::string>{"D"});
+
+	CHECK(g.erase_node("D"));
+	CHECK(g.begin() == g.end());
+}
+
+TEST_CASE("Merge and Replace Node - Duplicate Edges Removed") {
+	auto g = gdwg::graph<std::string, int>{"A", "B", "C", "D"};
+	CHECK(g.insert_edge("A", "B", 1));
+	CHECK(g.insert_edge("A", "C", 2));
+	CHECK(g.insert_edge("A", "D", 3));
+	CHECK(g.insert_edge("B", "B", 1));
+	CHECK(g.insert_edge("C", "A", 4));
+
+	g.merge_replace_node("A", "B");
+
+	auto expected = gdwg::graph<std::string, int>{"B", "C", "D"};
+	CHECK(expected.insert_edge("B", "B", 1));
+	CHECK(expected.insert_edge("B", "C", 2));
+	CHECK(expected.insert_edge("B", "D", 3));
+	CHECK(expected.insert_edge("C", "B", 4));
+	CHECK(g == expected);
+
+	g.merge_replace_node("C", "C");
+	CHECK(g == expected);
+}
+
+TEST_CASE("Erase Node - Incoming and Outgoing Edges") {
+	auto g = gdwg::graph<int, int>{1, 2, 3};
+	CHECK(g.insert_edge(1, 2, 10));
+	CHECK(g.insert_edge(1, 2));
+	CHECK(g.insert_edge(2, 3, 20));
+	CHECK(g.insert_edge(3, 1, 30));
+	CHECK(g.insert_edge(1, 3, 40));
+
+	CHECK(g.erase_node(2));
+	REQUIRE_FALSE(g.erase_node(2));
+	CHECK(g.connections(1) == std::vector<int>{3});
+	CHECK(g.connections(3) == std::vector<int>{1});
+
+	CHECK(g.erase_node(1));
+	CHECK(g.connections(3).empty());
+	CHECK(g.begin() == g.end());
+}
+
 TEST_CASE("Erase Weighted Edge") {
 	auto g = gdwg::graph<int, int>{1, 2, 3};
 	CHECK(g.insert_edge(1, 2, 10));
@@ -292,6 +366,94 @@ TEST_CASE("Erase Edge - Between Iterators") {
 	CHECK(g.is_connected(3, 4));
 }
 
+TEST_CASE("Erase Edge - Pointed to by Iterator - Returns Next") {
+	auto g = gdwg::graph<int, int>{1, 2, 3};
+	CHECK(g.insert_edge(1, 2, 10));
+	CHECK(g.insert_edge(1, 3, 20));
+	CHECK(g.insert_edge(2, 3));
+
+	auto it = g.erase_edge(g.find(1, 3, 20));
+	CHECK((*it).from == 2);
+	CHECK((*it).to == 3);
+	CHECK((*it).weight == std::nullopt);
+
+	it = g.erase_edge(it);
+	CHECK(it == g.end());
+	CHECK(g.is_connected(1, 2));
+	REQUIRE_FALSE(g.is_connected(2, 3));
+}
+
+TEST_CASE("Erase Edge - Between Iterators - Across Sources") {
+	auto g = gdwg::graph<int, int>{1, 2, 3, 4};
+	CHECK(g.insert_edge(1, 2, 10));
+	CHECK(g.insert_edge(1, 3, 20));
+	CHECK(g.insert_edge(2, 3, 40));
+	CHECK(g.insert_edge(3, 4, 50));
+	CHECK(g.insert_edge(3, 4));
+
+	auto it = g.erase_edge(g.find(1, 3, 20), g.find(3, 4, 50));
+	CHECK((*it).from == 3);
+	CHECK((*it).to == 4);
+	CHECK((*it).weight == 50);
+	CHECK(g.is_connected(1, 2));
+	REQUIRE_FALSE(g.is_connected(1, 3));
+	REQUIRE_FALSE(g.is_connected(2, 3));
+	CHECK(g.find(3, 4) == g.end());
+	CHECK(g.find(3, 4, 50) != g.end());
+
+	CHECK(g.erase_edge(g.begin(), g.end()) == g.end());
+	CHECK(g.begin() == g.end());
+	REQUIRE_FALSE(g.is_connected(3, 4));
+}
+
+TEST_CASE("Erase Edge - Between Iterators - Same Source") {
+	auto g = gdwg::graph<std::string, int>{"a", "b", "c"};
+	CHECK(g.insert_edge("a", "b"));
+	CHECK(g.insert_edge("a", "b", 1));
+	CHECK(g.insert_edge("a", "b", 2));
+	CHECK(g.insert_edge("a", "c", 3));
+
+	auto it = g.erase_edge(g.find("a", "b"), g.find("a", "b", 2));
+	CHECK((*it).from == "a");
+	CHECK((*it).to == "b");
+	CHECK((*it).weight == 2);
+	++it;
+	CHECK((*it).to == "c");
+	CHECK(++it == g.end());
+	CHECK(g.edges("a", "b").size() == 1);
+}
+
+TEST_CASE("Erase Edge - Between Iterators - Into a High In-Degree Node") {
+	auto g = gdwg::graph<int, int>{0};
+	for (auto src = 1; src <= 200; ++src) {
+		CHECK(g.insert_node(src));
+		CHECK(g.insert_edge(src, 0));
+		CHECK(g.insert_edge(src, 0, src));
+	}
+	auto const hub = *g.id_of(0);
+	REQUIRE(g.in_edges(hub).size() == 400);
+
+	auto it = g.erase_edge(g.find(50, 0, 50), g.find(150, 0));
+	CHECK((*it).from == 150);
+	CHECK(g.edge_count() == 400 - 199);
+	auto sources = std::vector<int>{};
+	for (auto const src : g.in_edges(hub)) {
+		sources.push_back(g.node(src));
+	}
+	std::sort(sources.begin(), sources.end());
+	auto expected = std::vector<int>{};
+	for (auto const& [from, to, weight] : g) {
+		expected.push_back(from);
+	}
+	CHECK(sources == expected);
+	CHECK(g.edges(50, 0).size() == 1);
+	REQUIRE_FALSE(g.is_connected(100, 0));
+
+	CHECK(g.erase_edge(g.begin(), g.end()) == g.end());
+	CHECK(g.in_edges(hub).empty());
+	CHECK(g.edge_count() == 0);
+}
+
 TEST_CASE("Clear All Nodes with Edges from Graph") {
 	auto g = gdwg::graph<int, int>{1, 2, 3};
 	g.clear();
@@ -397,6 +559,25 @@ TEST_CASE("Accessor - Edges - Mix Edge Type") {
 	CHECK(edges[2]->get_weight() == 20);
 }
 
+TEST_CASE("Accessor - Edges - Only Requested Destination") {
+	auto g = gdwg::graph<int, int>{1, 2, 3};
+	CHECK(g.insert_edge(1, 3, 5));
+	CHECK(g.insert_edge(1, 2, 20));
+	CHECK(g.insert_edge(1, 2));
+	CHECK(g.insert_edge(1, 2, -10));
+	CHECK(g.insert_edge(1, 1, 0));
+	REQUIRE_FALSE(g.insert_edge(1, 2, -10));
+
+	auto edges = g.edges(1, 2);
+	REQUIRE(edges.size() == 3);
+	CHECK(edges[0]->get_nodes() == std::make_pair(1, 2));
+	CHECK(edges[0]->get_weight() == std::nullopt);
+	CHECK(edges[1]->get_weight() == -10);
+	CHECK(edges[2]->get_weight() == 20);
+	CHECK(g.edges(2, 1).empty());
+	CHECK(g.connections(1) == std::vector<int>{1, 2, 3});
+}
+
 TEST_CASE("Accessor - Edges - Throw Error") {
 	auto g = gdwg::graph<int, int>{1, 2};
 	REQUIRE_THROWS_WITH(g.edges(1, 4),
@@ -453,6 +634,44 @@ TEST_CASE("Accessor - Connections - Throw Error") {
 	REQUIRE_THROWS_WITH(g.connections(4), "Cannot call gdwg::graph<N, E>::connections if src doesn't exist in the graph");
 }
 
+TEST_CASE("Accessor - Edges View") {
+	auto g = gdwg::graph<int, int>{1, 2, 3};
+	CHECK(g.insert_edge(1, 3, 5));
+	CHECK(g.insert_edge(1, 2, 20));
+	CHECK(g.insert_edge(1, 2));
+	CHECK(g.insert_edge(1, 2, -10));
+
+	auto view = g.edges_view(1, 2);
+	REQUIRE(view.size() == 3);
+	CHECK(g.node(view[0].dst) == 2);
+	CHECK(view[0].weight == std::nullopt);
+	CHECK(view[1].weight == -10);
+	CHECK(view[2].weight == 20);
+	CHECK(g.edges_view(1, 1).empty());
+	CHECK(g.edges_view(2, 3).empty());
+	REQUIRE_THROWS_WITH(g.edges_view(1, 4),
+	                    "Cannot call gdwg::graph<N, E>::edges_view if src or dst node don't exist in the graph");
+}
+
+TEST_CASE("Accessor - Connections View") {
+	using graph = gdwg::graph<std::string, int>;
+	STATIC_REQUIRE(std::ranges::forward_range<graph::connection_range>);
+
+	auto g = graph{"a", "b", "c"};
+	CHECK(g.insert_edge("a", "c"));
+	CHECK(g.insert_edge("a", "b", 1));
+	CHECK(g.insert_edge("a", "b", 2));
+	CHECK(g.insert_edge("a", "a"));
+
+	auto view = g.connections_view("a");
+	CHECK(std::vector<std::string>(view.begin(), view.end()) == g.connections("a"));
+	CHECK(std::ranges::distance(view) == 3);
+	CHECK(g.connections_view("b").empty());
+	CHECK(g.connections_view("b").begin() == g.connections_view("b").end());
+	REQUIRE_THROWS_WITH(g.connections_view("d"),
+	                    "Cannot call gdwg::graph<N, E>::connections_view if src doesn't exist in the graph");
+}
+
 TEST_CASE("Iterator Access - Begin") {
 	auto g = gdwg::graph<int, int>{1, 2, 3};
 	CHECK(g.insert_edge(1, 2, 10));
@@ -575,6 +794,62 @@ TEST_CASE("Graph Extractor - Output Operator - Complex") {
 	CHECK(os.str() == expected_os);
 }
 
+TEST_CASE("Graph Extractor - Output Operator - Strings and Floating Weights") {
+	auto g = gdwg::graph<std::string, double>{"b", "a"};
+	CHECK(g.insert_edge("a", "b", 0.5));
+	CHECK(g.insert_edge("a", "b"));
+	CHECK(g.insert_edge("b", "a", 1234567.0));
+
+	std::ostringstream os;
+	os << g;
+	auto const expected_os = std::string_view(R"(a (
+  a -> b | U
+  a -> b | W | 0.5
+)
+b (
+  b -> a | W | 1.23457e+06
+)
+)");
+	CHECK(os.str() == expected_os);
+}
+
+TEST_CASE("Graph Extractor - Output Operator - Stream Formatting") {
+	auto g = gdwg::graph<int, int>{10, 255};
+	CHECK(g.insert_edge(255, 10, 16));
+
+	std::ostringstream os;
+	os << std::hex << g;
+	auto const expected_os = std::string_view(R"(a (
+)
+ff (
+  ff -> a | W | 10
+)
+)");
+	CHECK(os.str() == expected_os);
+}
+
+TEST_CASE("Graph Extractor - Output Operator - Larger Than Buffer") {
+	auto g = gdwg::graph<int, long>{};
+	auto expected = std::ostringstream{};
+	for (auto i = 0; i < 5000; ++i) {
+		CHECK(g.insert_node(i));
+	}
+	for (auto i = 0; i < 5000; ++i) {
+		expected << i << " (\n";
+		if (i + 1 < 5000) {
+			CHECK(g.insert_edge(i, i + 1));
+			CHECK(g.insert_edge(i, i + 1, -1000000L * i));
+			expected << "  " << i << " -> " << i + 1 << " | U\n";
+			expected << "  " << i << " -> " << i + 1 << " | W | " << -1000000L * i << "\n";
+		}
+		expected << ")\n";
+	}
+
+	std::ostringstream os;
+	os << g;
+	CHECK(os.str() == expected.str());
+}
+
 TEST_CASE("Iterator - Default Constructor") {}
 
 TEST_CASE("Iterator - Explicit Constructor") {}
@@ -638,7 +913,7 @@ TEST_CASE("Iterator - Post-Decrement Operator") {
 	g.insert_edge(1, 2, 10);
 	g.insert_edge(1, 3, 20);
 	auto it = g.end();
-	*it--;
+	it--;
 	auto [src, dst, weight] = *it--;
 	CHECK(src == 1);
 	CHECK(dst == 3);
@@ -658,3 +933,177 @@ TEST_CASE("Iterator - Equality Operator") {
 	++it1;
 	REQUIRE_FALSE(it1 == it2);
 }
+
+TEST_CASE("Dense Access - Interned Ids") {
+	auto g = gdwg::graph<std::string, int>{"a", "b", "c"};
+	CHECK(g.insert_edge("a", "b", 1));
+	CHECK(g.insert_edge("c", "b"));
+	CHECK(g.insert_edge("b", "b", 2));
+	CHECK(g.node_count() == 3);
+	CHECK(g.edge_count() == 3);
+
+	auto b = g.id_of("b");
+	REQUIRE(b.has_value());
+	CHECK(g.node(*b) == "b");
+	CHECK(g.id_of("d") == std::nullopt);
+	CHECK(g.in_edges(*b).size() == 3);
+	REQUIRE(g.out_edges(*b).size() == 1);
+	CHECK(g.out_edges(*b)[0].dst == *b);
+	CHECK(g.out_edges(*b)[0].weight == 2);
+
+	// Erasing a node keeps ids dense in [0, node_count()).
+	CHECK(g.erase_node("a"));
+	CHECK(g.node_count() == 2);
+	CHECK(g.edge_count() == 2);
+	for (auto const& value : g.nodes()) {
+		auto id = g.id_of(value);
+		REQUIRE(id.has_value());
+		CHECK(*id < g.node_count());
+		CHECK(g.node(*id) == value);
+	}
+}
+
+TEST_CASE("Modifier - Insert Nodes - Batch") {
+	auto g = gdwg::graph<int, int>{1, 2};
+	auto values = std::vector<int>{3, 1, 4, 3, 5};
+	CHECK(g.insert_nodes(values) == 3);
+	CHECK(g.nodes() == std::vector<int>{1, 2, 3, 4, 5});
+	CHECK(g.insert_nodes(std::vector<int>{}, 100) == 0);
+	CHECK(g.node_count() == 5);
+}
+
+TEST_CASE("Modifier - Insert Edges - Batch") {
+	auto nodes = std::vector<int>{1, 2, 3, 4};
+	auto batch = std::vector<std::tuple<int, int, std::optional<int>>>{
+	    {3, 1, 2},
+	    {1, 2, std::nullopt},
+	    {1, 2, 5},
+	    {3, 1, 2},
+	    {4, 4, 1},
+	    {1, 2, 3},
+	    {2, 1, std::nullopt},
+	};
+
+	SECTION("Matches inserting edge by edge") {
+		auto g = gdwg::graph<int, int>(nodes.begin(), nodes.end());
+		CHECK(g.insert_edge(1, 2, 3));
+		CHECK(g.insert_edge(2, 3, 7));
+		auto expected = g;
+		for (auto const& [src, dst, weight] : batch) {
+			expected.insert_edge(src, dst, weight);
+		}
+		CHECK(g.insert_edges(batch) == 5);
+		CHECK(g == expected);
+		CHECK(g.edge_count() == 7);
+		CHECK(g.in_edges(*g.id_of(1)).size() == 2);
+		CHECK(g.in_edges(*g.id_of(2)).size() == 3);
+
+		std::ostringstream out;
+		std::ostringstream expected_out;
+		out << g;
+		expected_out << expected;
+		CHECK(out.str() == expected_out.str());
+	}
+
+	SECTION("Accepts another graph's edges") {
+		auto source = gdwg::graph<int, int>(nodes.begin(), nodes.end());
+		source.insert_edges(batch);
+		auto copy = gdwg::graph<int, int>(nodes.begin(), nodes.end());
+		CHECK(copy.insert_edges(source) == source.edge_count());
+		CHECK(copy == source);
+	}
+
+	SECTION("Throws without modifying the graph when a node is missing") {
+		auto g = gdwg::graph<int, int>(nodes.begin(), nodes.end());
+		batch.emplace_back(1, 9, 1);
+		CHECK_THROWS_MATCHES(g.insert_edges(batch),
+		                     std::runtime_error,
+		                     Catch::Matchers::Message("Cannot call gdwg::graph<N, E>::insert_edges when either src or "
+		                                              "dst node does not exist"));
+		CHECK(g.edge_count() == 0);
+		CHECK(g.begin() == g.end());
+	}
+}
+
+TEST_CASE("Graph - Randomised Mutations Match Reference") {
+	using edge_tuple = std::tuple<int, int, std::optional<int>>;
+	auto g = gdwg::graph<int, int>{};
+	auto nodes = std::set<int>{};
+	auto edges = std::set<edge_tuple>{};
+	auto rng = std::mt19937{2024};
+	auto const pick = [&rng](int bound) { return std::uniform_int_distribution<int>{0, bound - 1}(rng); };
+	auto const pick_weight = [&pick]() { return pick(4) == 0 ? std::nullopt : std::optional<int>{pick(3)}; };
+
+	for (auto step = 0; step < 2000; ++step) {
+		auto const a = pick(12);
+		auto const b = pick(12);
+		switch (pick(7)) {
+		case 0:
+		case 1: CHECK(g.insert_node(a) == nodes.insert(a).second); break;
+		case 2:
+			if (nodes.contains(a) and nodes.contains(b)) {
+				auto const w = pick_weight();
+				CHECK(g.insert_edge(a, b, w) == edges.emplace(a, b, w).second);
+			}
+			break;
+		case 3:
+			if (nodes.contains(a) and nodes.contains(b)) {
+				auto const w = pick_weight();
+				CHECK(g.erase_edge(a, b, w) == (edges.erase({a, b, w}) == 1));
+			}
+			break;
+		case 4:
+			CHECK(g.erase_node(a) == (nodes.erase(a) == 1));
+			std::erase_if(edges, [a](auto const& e) { return std::get<0>(e) == a or std::get<1>(e) == a; });
+			break;
+		case 5:
+			if (nodes.contains(a) and !nodes.contains(b)) {
+				CHECK(g.replace_node(a, b));
+				nodes.erase(a);
+				nodes.insert(b);
+				auto renamed = std::set<edge_tuple>{};
+				for (auto [src, dst, w] : edges) {
+					renamed.emplace(src == a ? b : src, dst == a ? b : dst, w);
+				}
+				edges = renamed;
+			}
+			break;
+		case 6:
+			if (nodes.contains(a) and nodes.contains(b)) {
+				g.merge_replace_node(a, b);
+				if (a != b) {
+					nodes.erase(a);
+					auto merged = std::set<edge_tuple>{};
+					for (auto [src, dst, w] : edges) {
+						merged.emplace(src == a ? b : src, dst == a ? b : dst, w);
+					}
+					edges = merged;
+				}
+			}
+			break;
+		}
+
+		REQUIRE(g.nodes() == std::vector<int>(nodes.begin(), nodes.end()));
+		REQUIRE(g.edge_count() == edges.size());
+		auto actual = std::vector<edge_tuple>{};
+		for (auto const& [from, to, weight] : g) {
+			actual.emplace_back(from, to, weight);
+		}
+		REQUIRE(actual == std::vector<edge_tuple>(edges.begin(), edges.end()));
+		for (auto const node : nodes) {
+			auto const id = *g.id_of(node);
+			auto expected_sources = std::vector<int>{};
+			for (auto const& [src, dst, w] : edges) {
+				if (dst == node) {
+					expected_sources.push_back(src);
+				}
+			}
+			auto sources = std::vector<int>{};
+			for (auto const src : g.in_edges(id)) {
+				sources.push_back(g.node(src));
+			}
+			std::sort(sources.begin(), sources.end());
+			REQUIRE(sources == expected_sources);
+		}
+	}
+}
@@ -0,0 +1,365 @@
+#ifndef GDWG_PAGERANK_H
+#define GDWG_PAGERANK_H
+
+#include "gdwg_graph.h"
+#include "gdwg_parallel.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace gdwg {
+	struct pagerank_options {
+		double damping = 0.85;
+		// Iteration stops once the L1 change in the rank vector falls below this.
+		double tolerance = 1e-6;
+		std::size_t max_iterations = 100;
+		// The weight weighted_pagerank gives an unweighted edge. pagerank ignores weights.
+		double unweighted_weight = 1.0;
+		// Threads used when no worker_pool is supplied. Zero uses every hardware thread.
+		std::size_t threads = 0;
+	};
+
+	struct pagerank_result {
+		// The rank of each node, indexed by the graph's dense node ids. Ranks sum to one.
+		std::vector<double> ranks;
+		// The L1 change in the rank vector after each iteration.
+		std::vector<double> residuals;
+		bool converged = false;
+
+		[[nodiscard]] auto iterations() const noexcept -> std::size_t {
+			return residuals.size();
+		}
+	};
+
+	namespace detail {
+		// The transition matrix transposed into compressed sparse columns: the in-edges of v occupy
+		// [offsets[v], offsets[v + 1]) of sources and shares, where each share is the fraction of
+		// its source's rank that flows along that edge. A node whose out-edges carry no weight is
+		// dangling and spreads its rank over every node instead.
+		struct pull_matrix {
+			std::vector<std::size_t> offsets;
+			std::vector<std::uint32_t> sources;
+			std::vector<double> shares;
+			std::vector<std::uint32_t> dangling;
+		};
+
+		template<bool Weighted, typename N, typename E>
+		auto make_pull_matrix(graph<N, E> const& g, pagerank_options const& options) -> pull_matrix {
+			auto const n = g.node_count();
+			auto matrix = pull_matrix{};
+			matrix.offsets.assign(n + 1, 0);
+			for (auto v = std::uint32_t{0}; v < n; ++v) {
+				matrix.offsets[v + 1] = matrix.offsets[v] + g.in_edges(v).size();
+			}
+			matrix.sources.resize(g.edge_count());
+			matrix.shares.resize(g.edge_count());
+
+			auto const weight_of = [&options](auto const& record) -> double {
+				if constexpr (Weighted) {
+					auto const weight = record.weight ? static_cast<double>(*record.weight) : options.unweighted_weight;
+					if (weight < 0.0) {
+						throw std::runtime_error("Cannot call gdwg::weighted_pagerank with negative edge weights");
+					}
+					return weight;
+				}
+				else {
+					return 1.0;
+				}
+			};
+			auto cursor = std::vector<std::size_t>(matrix.offsets.begin(), matrix.offsets.end() - 1);
+			for (auto u = std::uint32_t{0}; u < n; ++u) {
+				auto const edges = g.out_edges(u);
+				auto total = 0.0;
+				for (auto const& record : edges) {
+					total += weight_of(record);
+				}
+				if (total == 0.0) {
+					matrix.dangling.push_back(u);
+				}
+				for (auto const& record : edges) {
+					auto const slot = cursor[record.dst]++;
+					matrix.sources[slot] = u;
+					matrix.shares[slot] = total == 0.0 ? 0.0 : weight_of(record) / total;
+				}
+			}
+			return matrix;
+		}
+	} // namespace detail
+
+	namespace detail {
+		// Power iteration over matrix. Each iteration is a pull-based sparse matrix-vector product:
+		// every node gathers rank along its in-edges, so nodes are updated independently on pool's
+		// workers with no atomics.
+		inline auto power_iteration(pull_matrix const& matrix, worker_pool& pool, pagerank_options const& options)
+		    -> pagerank_result {
+			auto const n = matrix.offsets.size() - 1;
+			auto result = pagerank_result{};
+			auto const size = static_cast<double>(n);
+			auto& ranks = result.ranks;
+			ranks.assign(n, 1.0 / size);
+			auto next = std::vector<double>(n);
+			auto partial_residuals = std::vector<double>(pool.size());
+
+			for (auto iteration = std::size_t{0}; iteration < options.max_iterations; ++iteration) {
+				auto dangling = 0.0;
+				for (auto u : matrix.dangling) {
+					dangling += ranks[u];
+				}
+				auto const base = (1.0 - options.damping) / size + options.damping * dangling / size;
+				std::fill(partial_residuals.begin(), partial_residuals.end(), 0.0);
+				pool.for_each_block(n, 2048, [&](std::size_t worker, std::size_t first, std::size_t last) {
+					auto residual = 0.0;
+					for (auto v = first; v < last; ++v) {
+						auto sum = 0.0;
+						for (auto k = matrix.offsets[v]; k < matrix.offsets[v + 1]; ++k) {
+							sum += matrix.shares[k] * ranks[matrix.sources[k]];
+						}
+						next[v] = base + options.damping * sum;
+						residual += std::abs(next[v] - ranks[v]);
+					}
+					partial_residuals[worker] += residual;
+				});
+				std::swap(ranks, next);
+				result.residuals.push_back(std::accumulate(partial_residuals.begin(), partial_residuals.end(), 0.0));
+				if (result.residuals.back() < options.tolerance) {
+					result.converged = true;
+					break;
+				}
+			}
+			return result;
+		}
+
+		template<bool Weighted, typename N, typename E>
+		auto pagerank(graph<N, E> const& g, worker_pool& pool, pagerank_options const& options, char const* function)
+		    -> pagerank_result {
+			if (!(options.damping >= 0.0 and options.damping <= 1.0)) {
+				throw std::runtime_error(std::string("Cannot call ") + function + " with damping outside [0, 1]");
+			}
+			if (g.node_count() == 0) {
+				auto result = pagerank_result{};
+				result.converged = true;
+				return result;
+			}
+			return power_iteration(make_pull_matrix<Weighted>(g, options), pool, options);
+		}
+	} // namespace detail
+
+	// PageRank by power iteration, with each node's rank split evenly over its out-edges whatever
+	// their weights. Dangling nodes spread their rank evenly over all nodes.
+	template<typename N, typename E>
+	auto pagerank(graph<N, E> const& g, worker_pool& pool, pagerank_options const& options) -> pagerank_result {
+		return detail::pagerank<false>(g, pool, options, "gdwg::pagerank");
+	}
+
+	template<typename N, typename E>
+	auto pagerank(graph<N, E> const& g, pagerank_options const& options) -> pagerank_result {
+		auto pool = worker_pool(options.threads);
+		return pagerank(g, pool, options);
+	}
+
+	template<typename N, typename E>
+	auto pagerank(graph<N, E> const& g,
+	              double damping = 0.85,
+	              double tolerance = 1e-6,
+	              std::size_t max_iterations = 100) -> pagerank_result {
+		auto options = pagerank_options{};
+		options.damping = damping;
+		options.tolerance = tolerance;
+		options.max_iterations = max_iterations;
+		return pagerank(g, options);
+	}
+
+	// PageRank with each node's rank split over its out-edges in proportion to their weights,
+	// counting unweighted edges as options.unweighted_weight. Only numeric weights can steer the
+	// walk, so other edge types do not compile. Throws std::runtime_error on a negative weight.
+	template<typename N, typename E>
+	requires std::is_arithmetic_v<E>
+	auto weighted_pagerank(graph<N, E> const& g, worker_pool& pool, pagerank_options const& options)
+	    -> pagerank_result {
+		return detail::pagerank<true>(g, pool, options, "gdwg::weighted_pagerank");
+	}
+
+	template<typename N, typename E>
+	requires std::is_arithmetic_v<E>
+	auto weighted_pagerank(graph<N, E> const& g, pagerank_options const& options = {}) -> pagerank_result {
+		auto pool = worker_pool(options.threads);
+		return weighted_pagerank(g, pool, options);
+	}
+
+	struct personalized_pagerank_options {
+		double damping = 0.85;
+		// A node is pushed once its residual reaches epsilon times its out-degree (or epsilon if it
+		// has no out-edges). Smaller values give more accurate ranks at more work.
+		double epsilon = 1e-6;
+		// Threads used by the batched overload when no worker_pool is supplied. Zero uses every
+		// hardware thread.
+		std::size_t threads = 0;
+	};
+
+	// Approximate personalized PageRank from a single seed. The true rank of every node exceeds its
+	// estimate by at most residual in total, and estimates plus residual always sum to one.
+	struct push_result {
+		// (node id, estimate) for every node with a nonzero estimate, in ascending id order.
+		std::vector<std::pair<std::uint32_t, double>> ranks;
+		// The rank mass not yet pushed into any estimate.
+		double residual = 0.0;
+		std::size_t pushes = 0;
+	};
+
+	// Scratch space for personalized_pagerank. It is sized to the graph on first use and left
+	// clean after every query, so later queries over graphs of the same size allocate nothing
+	// beyond their results. Not safe to share between concurrent queries.
+	struct push_workspace {
+		std::vector<double> estimates;
+		std::vector<double> residuals;
+		std::vector<char> flags;
+		std::vector<std::uint32_t> touched;
+		std::vector<std::uint32_t> queue;
+	};
+
+	namespace detail {
+		inline auto check_push_options(personalized_pagerank_options const& options) -> void {
+			if (!(options.damping >= 0.0 and options.damping < 1.0)) {
+				throw std::runtime_error("Cannot call gdwg::personalized_pagerank with damping outside [0, 1)");
+			}
+			if (!(options.epsilon > 0.0)) {
+				throw std::runtime_error("Cannot call gdwg::personalized_pagerank with a non-positive epsilon");
+			}
+		}
+
+		template<typename N, typename E>
+		auto forward_push(graph<N, E> const& g,
+		                  std::uint32_t seed,
+		                  push_workspace& workspace,
+		                  personalized_pagerank_options const& options) -> push_result {
+			constexpr auto touched_flag = char{1};
+			constexpr auto queued_flag = char{2};
+			if (workspace.residuals.size() != g.node_count()) {
+				workspace.estimates.assign(g.node_count(), 0.0);
+				workspace.residuals.assign(g.node_count(), 0.0);
+				workspace.flags.assign(g.node_count(), 0);
+			}
+			auto& estimates = workspace.estimates;
+			auto& residuals = workspace.residuals;
+			auto& flags = workspace.flags;
+			auto& touched = workspace.touched;
+			auto& queue = workspace.queue;
+			auto const threshold = [&](std::uint32_t v) {
+				return options.epsilon * static_cast<double>(std::max(g.out_edges(v).size(), std::size_t{1}));
+			};
+			auto const add = [&](std::uint32_t v, double mass) {
+				if ((flags[v] & touched_flag) == 0) {
+					flags[v] |= touched_flag;
+					touched.push_back(v);
+				}
+				residuals[v] += mass;
+				if ((flags[v] & queued_flag) == 0 and residuals[v] >= threshold(v)) {
+					flags[v] |= queued_flag;
+					queue.push_back(v);
+				}
+			};
+
+			auto result = push_result{};
+			add(seed, 1.0);
+			for (auto head = std::size_t{0}; head < queue.size(); ++head) {
+				auto const u = queue[head];
+				flags[u] &= ~queued_flag;
+				auto const mass = residuals[u];
+				residuals[u] = 0.0;
+				estimates[u] += (1.0 - options.damping) * mass;
+				++result.pushes;
+				// A walk stuck at a node with no out-edges restarts from the seed.
+				auto const edges = g.out_edges(u);
+				if (edges.empty()) {
+					add(seed, options.damping * mass);
+					continue;
+				}
+				auto const share = options.damping * mass / static_cast<double>(edges.size());
+				for (auto const& record : edges) {
+					add(record.dst, share);
+				}
+			}
+
+			std::sort(touched.begin(), touched.end());
+			for (auto v : touched) {
+				if (estimates[v] > 0.0) {
+					result.ranks.emplace_back(v, estimates[v]);
+				}
+				result.residual += residuals[v];
+				estimates[v] = 0.0;
+				residuals[v] = 0.0;
+				flags[v] = 0;
+			}
+			touched.clear();
+			queue.clear();
+			return result;
+		}
+	} // namespace detail
+
+	// Personalized PageRank from seed by local forward push (Andersen, Chung and Lang). Work is
+	// bounded by 1 / ((1 - damping) * epsilon) pushes whatever the size of the graph, and only
+	// nodes near the seed are ever touched. Each edge carries an equal share of its source's rank.
+	template<typename N, typename E>
+	auto personalized_pagerank(graph<N, E> const& g,
+	                           std::type_identity_t<N> const& seed,
+	                           push_workspace& workspace,
+	                           personalized_pagerank_options const& options = {}) -> push_result {
+		detail::check_push_options(options);
+		auto const id =
+		    detail::id_or_throw(g, seed, "Cannot call gdwg::personalized_pagerank if seed doesn't exist in the graph");
+		return detail::forward_push(g, id, workspace, options);
+	}
+
+	template<typename N, typename E>
+	auto personalized_pagerank(graph<N, E> const& g,
+	                           std::type_identity_t<N> const& seed,
+	                           personalized_pagerank_options const& options = {}) -> push_result {
+		auto workspace = push_workspace{};
+		return personalized_pagerank(g, seed, workspace, options);
+	}
+
+	// Personalized PageRank from each of seeds, one query per seed, spread over pool's workers.
+	// Each worker keeps one workspace for all of its queries.
+	template<typename N, typename E>
+	auto personalized_pagerank(graph<N, E> const& g,
+	                           std::vector<N> const& seeds,
+	                           worker_pool& pool,
+	                           personalized_pagerank_options const& options = {}) -> std::vector<push_result> {
+		detail::check_push_options(options);
+		auto ids = std::vector<std::uint32_t>{};
+		ids.reserve(seeds.size());
+		for (auto const& seed : seeds) {
+			ids.push_back(detail::id_or_throw(g,
+			                                  seed,
+			                                  "Cannot call gdwg::personalized_pagerank if seed doesn't exist in the "
+			                                  "graph"));
+		}
+		auto results = std::vector<push_result>(ids.size());
+		auto workspaces = std::vector<push_workspace>(pool.size());
+		pool.for_each(
+		    ids.size(),
+		    [&](std::size_t worker, std::size_t i) {
+			    results[i] = detail::forward_push(g, ids[i], workspaces[worker], options);
+		    },
+		    1);
+		return results;
+	}
+
+	template<typename N, typename E>
+	auto personalized_pagerank(graph<N, E> const& g,
+	                           std::vector<N> const& seeds,
+	                           personalized_pagerank_options const& options = {}) -> std::vector<push_result> {
+		auto pool = worker_pool(options.threads);
+		return personalized_pagerank(g, seeds, pool, options);
+	}
+} // namespace gdwg
+
+#endif // GDWG_PAGERANK_H
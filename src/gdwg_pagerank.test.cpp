@@ -0,0 +1,292 @@
+#include "gdwg_pagerank.h"
+
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <optional>
+#include <random>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace {
+	auto sum(std::vector<double> const& values) -> double {
+		return std::accumulate(values.begin(), values.end(), 0.0);
+	}
+
+	// Dense power iteration over the full transition matrix, for comparison.
+	auto reference_pagerank(gdwg::graph<int, double> const& g, double damping, bool weighted)
+	    -> std::vector<double> {
+		auto const n = g.node_count();
+		auto transition = std::vector<std::vector<double>>(n, std::vector<double>(n, 0.0));
+		for (auto u = std::uint32_t{0}; u < n; ++u) {
+			auto total = 0.0;
+			for (auto const& record : g.out_edges(u)) {
+				total += weighted ? record.weight.value_or(1.0) : 1.0;
+			}
+			for (auto v = std::uint32_t{0}; v < n; ++v) {
+				transition[u][v] = total == 0.0 ? 1.0 / static_cast<double>(n) : 0.0;
+			}
+			for (auto const& record : g.out_edges(u)) {
+				transition[u][record.dst] += (weighted ? record.weight.value_or(1.0) : 1.0) / total;
+			}
+		}
+		auto ranks = std::vector<double>(n, 1.0 / static_cast<double>(n));
+		for (auto iteration = 0; iteration < 1000; ++iteration) {
+			auto next = std::vector<double>(n, (1.0 - damping) / static_cast<double>(n));
+			for (auto u = std::size_t{0}; u < n; ++u) {
+				for (auto v = std::size_t{0}; v < n; ++v) {
+					next[v] += damping * ranks[u] * transition[u][v];
+				}
+			}
+			ranks = next;
+		}
+		return ranks;
+	}
+
+	auto make_random(int nodes, int edges, unsigned seed) -> gdwg::graph<int, double> {
+		auto g = gdwg::graph<int, double>{};
+		for (auto v = 0; v < nodes; ++v) {
+			g.insert_node(v);
+		}
+		auto engine = std::mt19937(seed);
+		auto node = std::uniform_int_distribution<int>(0, nodes - 1);
+		auto weight = std::uniform_int_distribution<int>(1, 9);
+		for (auto i = 0; i < edges; ++i) {
+			auto const src = node(engine);
+			auto const dst = node(engine);
+			if (i % 4 == 0) {
+				g.insert_edge(src, dst);
+			}
+			else {
+				g.insert_edge(src, dst, weight(engine));
+			}
+		}
+		return g;
+	}
+} // namespace
+
+TEST_CASE("PageRank - Matches Dense Power Iteration") {
+	auto const weighted = GENERATE(false, true);
+	auto const threads = GENERATE(std::size_t{1}, std::size_t{4});
+	auto const g = make_random(300, 900, 7);
+	auto options = gdwg::pagerank_options{};
+	options.tolerance = 1e-12;
+	options.max_iterations = 1000;
+	options.threads = threads;
+	auto const result = weighted ? gdwg::weighted_pagerank(g, options) : gdwg::pagerank(g, options);
+	CHECK(result.converged);
+	CHECK(sum(result.ranks) == Approx(1.0));
+	auto const expected = reference_pagerank(g, options.damping, weighted);
+	for (auto v = std::size_t{0}; v < expected.size(); ++v) {
+		CHECK(result.ranks[v] == Approx(expected[v]).margin(1e-9));
+	}
+}
+
+TEST_CASE("PageRank - Dangling Nodes Keep The Total") {
+	auto g = gdwg::graph<std::string, int>{"a", "b", "c", "sink"};
+	g.insert_edge("a", "b");
+	g.insert_edge("b", "c");
+	g.insert_edge("c", "a");
+	g.insert_edge("c", "sink");
+	auto const result = gdwg::pagerank(g, 0.85, 1e-10, 500);
+	REQUIRE(result.converged);
+	CHECK(sum(result.ranks) == Approx(1.0));
+	CHECK(result.ranks[*g.id_of("sink")] > 0.0);
+	CHECK(result.ranks[*g.id_of("b")] > result.ranks[*g.id_of("a")]);
+	CHECK(result.ranks[*g.id_of("sink")] == Approx(result.ranks[*g.id_of("a")]));
+}
+
+TEST_CASE("PageRank - Symmetric Cycle Is Uniform") {
+	auto g = gdwg::graph<int, int>{0, 1, 2, 3};
+	for (auto v = 0; v < 4; ++v) {
+		g.insert_edge(v, (v + 1) % 4);
+	}
+	auto const result = gdwg::pagerank(g);
+	REQUIRE(result.converged);
+	for (auto rank : result.ranks) {
+		CHECK(rank == Approx(0.25));
+	}
+	CHECK(result.iterations() == 1);
+}
+
+TEST_CASE("PageRank - Weights Steer The Walk") {
+	auto g = gdwg::graph<char, double>{'h', 'x', 'y'};
+	g.insert_edge('h', 'x', 9.0);
+	g.insert_edge('h', 'y', 1.0);
+	g.insert_edge('x', 'h', 1.0);
+	g.insert_edge('y', 'h', 1.0);
+	auto options = gdwg::pagerank_options{};
+	auto const even = gdwg::pagerank(g, options);
+	CHECK(even.ranks[*g.id_of('x')] == Approx(even.ranks[*g.id_of('y')]));
+	auto const steered = gdwg::weighted_pagerank(g, options);
+	CHECK(steered.ranks[*g.id_of('x')] > 2 * steered.ranks[*g.id_of('y')]);
+}
+
+TEST_CASE("PageRank - Residuals Shrink And Respect The Limit") {
+	auto const g = make_random(200, 600, 11);
+	auto const result = gdwg::pagerank(g, 0.85, 0.0, 5);
+	CHECK(!result.converged);
+	REQUIRE(result.iterations() == 5);
+	CHECK(result.residuals.back() < result.residuals.front());
+}
+
+TEST_CASE("PageRank - Edge Cases And Errors") {
+	auto const empty = gdwg::graph<int, int>{};
+	auto const none = gdwg::pagerank(empty);
+	CHECK(none.ranks.empty());
+	CHECK(none.converged);
+
+	auto g = gdwg::graph<std::string, std::string>{"a", "b"};
+	g.insert_edge("a", "b", "label");
+	CHECK_THROWS_MATCHES(gdwg::pagerank(g, 1.5),
+	                     std::runtime_error,
+	                     Catch::Matchers::Message("Cannot call gdwg::pagerank with damping outside [0, 1]"));
+	// Only numeric weights can steer the walk.
+	constexpr auto weighable = []<typename G>(G const& graph) {
+		return requires { gdwg::weighted_pagerank(graph); };
+	};
+	STATIC_REQUIRE(!weighable(g));
+	STATIC_REQUIRE(weighable(empty));
+	CHECK(gdwg::pagerank(g).converged);
+
+	auto negative = gdwg::graph<int, int>{1, 2};
+	negative.insert_edge(1, 2, -3);
+	CHECK_THROWS_MATCHES(gdwg::weighted_pagerank(negative),
+	                     std::runtime_error,
+	                     Catch::Matchers::Message("Cannot call gdwg::weighted_pagerank with negative edge weights"));
+	auto options = gdwg::pagerank_options{};
+	options.damping = -0.5;
+	CHECK_THROWS_MATCHES(gdwg::weighted_pagerank(negative, options),
+	                     std::runtime_error,
+	                     Catch::Matchers::Message("Cannot call gdwg::weighted_pagerank with damping outside [0, 1]"));
+}
+
+namespace {
+	// Dense power iteration for personalized PageRank from seed, restarting at seed from nodes
+	// with no out-edges.
+	auto reference_personalized(gdwg::graph<int, double> const& g, std::uint32_t seed, double damping)
+	    -> std::vector<double> {
+		auto const n = g.node_count();
+		auto ranks = std::vector<double>(n, 0.0);
+		ranks[seed] = 1.0;
+		for (auto iteration = 0; iteration < 2000; ++iteration) {
+			auto next = std::vector<double>(n, 0.0);
+			next[seed] += 1.0 - damping;
+			for (auto u = std::uint32_t{0}; u < n; ++u) {
+				auto const edges = g.out_edges(u);
+				if (edges.empty()) {
+					next[seed] += damping * ranks[u];
+				}
+				for (auto const& record : edges) {
+					next[record.dst] += damping * ranks[u] / static_cast<double>(edges.size());
+				}
+			}
+			ranks = next;
+		}
+		return ranks;
+	}
+
+	auto check_against_reference(gdwg::graph<int, double> const& g, int seed, gdwg::push_result const& result)
+	    -> void {
+		auto const expected = reference_personalized(g, *g.id_of(seed), 0.85);
+		auto estimates = std::vector<double>(g.node_count(), 0.0);
+		auto total = result.residual;
+		for (auto const& [id, estimate] : result.ranks) {
+			estimates[id] = estimate;
+			total += estimate;
+		}
+		CHECK(total == Approx(1.0));
+		for (auto v = std::size_t{0}; v < expected.size(); ++v) {
+			CHECK(estimates[v] <= expected[v] + 1e-12);
+			CHECK(expected[v] - estimates[v] <= result.residual + 1e-12);
+		}
+	}
+} // namespace
+
+TEST_CASE("Personalized PageRank - Bounded By The Residual") {
+	auto const g = make_random(150, 500, 3);
+	auto const epsilon = GENERATE(1e-3, 1e-7);
+	auto options = gdwg::personalized_pagerank_options{};
+	options.epsilon = epsilon;
+	auto const result = gdwg::personalized_pagerank(g, 0, options);
+	CHECK(std::is_sorted(result.ranks.begin(), result.ranks.end()));
+	check_against_reference(g, 0, result);
+	if (epsilon < 1e-6) {
+		CHECK(result.residual < 1e-3);
+	}
+}
+
+TEST_CASE("Personalized PageRank - Work Depends On Epsilon Not Size") {
+	auto g = gdwg::graph<int, double>{};
+	auto nodes = std::vector<int>(200000);
+	std::iota(nodes.begin(), nodes.end(), 0);
+	g.insert_nodes(nodes);
+	auto edges = std::vector<std::tuple<int, int, std::optional<double>>>{};
+	for (auto v = 0; v + 1 < 200000; ++v) {
+		edges.emplace_back(v, v + 1, std::nullopt);
+	}
+	g.insert_edges(edges);
+	auto options = gdwg::personalized_pagerank_options{};
+	options.epsilon = 1e-3;
+	auto const result = gdwg::personalized_pagerank(g, 1000, options);
+	CHECK(result.pushes <= static_cast<std::size_t>(1.0 / ((1.0 - options.damping) * options.epsilon)));
+	CHECK(result.ranks.size() < 100);
+	CHECK(result.ranks.front().first == *g.id_of(1000));
+	CHECK(result.ranks.front().second == Approx(0.15));
+}
+
+TEST_CASE("Personalized PageRank - Workspace Is Reused Cleanly") {
+	auto const g = make_random(120, 400, 5);
+	auto workspace = gdwg::push_workspace{};
+	auto const first = gdwg::personalized_pagerank(g, 7, workspace);
+	auto const other = gdwg::personalized_pagerank(g, 42, workspace);
+	auto const again = gdwg::personalized_pagerank(g, 7, workspace);
+	CHECK(first.ranks == again.ranks);
+	CHECK(first.residual == again.residual);
+	check_against_reference(g, 42, other);
+
+	auto const small = make_random(10, 30, 9);
+	check_against_reference(small, 3, gdwg::personalized_pagerank(small, 3, workspace));
+}
+
+TEST_CASE("Personalized PageRank - Batched Seeds Match Single Queries") {
+	auto const g = make_random(300, 1200, 13);
+	auto const seeds = std::vector<int>{0, 5, 17, 99, 150, 299, 5};
+	auto options = gdwg::personalized_pagerank_options{};
+	options.epsilon = 1e-5;
+	options.threads = GENERATE(std::size_t{1}, std::size_t{4});
+	auto const results = gdwg::personalized_pagerank(g, seeds, options);
+	REQUIRE(results.size() == seeds.size());
+	for (auto i = std::size_t{0}; i < seeds.size(); ++i) {
+		auto const single = gdwg::personalized_pagerank(g, seeds[i], options);
+		CHECK(results[i].ranks == single.ranks);
+		CHECK(results[i].pushes == single.pushes);
+	}
+}
+
+TEST_CASE("Personalized PageRank - Errors") {
+	auto const g = make_random(5, 5, 1);
+	CHECK_THROWS_MATCHES(
+	    gdwg::personalized_pagerank(g, 9),
+	    std::runtime_error,
+	    Catch::Matchers::Message("Cannot call gdwg::personalized_pagerank if seed doesn't exist in the graph"));
+	CHECK_THROWS_MATCHES(
+	    gdwg::personalized_pagerank(g, std::vector<int>{0, 9}),
+	    std::runtime_error,
+	    Catch::Matchers::Message("Cannot call gdwg::personalized_pagerank if seed doesn't exist in the graph"));
+	auto options = gdwg::personalized_pagerank_options{};
+	options.epsilon = 0.0;
+	CHECK_THROWS_MATCHES(
+	    gdwg::personalized_pagerank(g, 0, options),
+	    std::runtime_error,
+	    Catch::Matchers::Message("Cannot call gdwg::personalized_pagerank with a non-positive epsilon"));
+	options.epsilon = 1e-4;
+	options.damping = 1.0;
+	CHECK_THROWS_MATCHES(
+	    gdwg::personalized_pagerank(g, 0, options),
+	    std::runtime_error,
+	    Catch::Matchers::Message("Cannot call gdwg::personalized_pagerank with damping outside [0, 1)"));
+}
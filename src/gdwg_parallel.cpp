@@ -0,0 +1 @@
+#include "gdwg_parallel.h"
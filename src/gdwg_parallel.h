@@ -0,0 +1,141 @@
+#ifndef GDWG_PARALLEL_H
+#define GDWG_PARALLEL_H
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace gdwg {
+	// A fixed set of threads that run data-parallel loops. The calling thread takes part in every
+	// loop as worker 0, so a pool of size one runs everything inline with no synchronisation.
+	class worker_pool {
+	 public:
+		// Constructors and Destructors
+		explicit worker_pool(std::size_t threads = 0)
+		: size_{std::max(std::size_t{1}, threads != 0 ? threads : std::size_t{std::thread::hardware_concurrency()})} {
+			threads_.reserve(size_ - 1);
+			for (auto worker = std::size_t{1}; worker < size_; ++worker) {
+				threads_.emplace_back([this, worker] { serve(worker); });
+			}
+		}
+
+		~worker_pool() {
+			{
+				auto lock = std::lock_guard(mutex_);
+				stopping_ = true;
+			}
+			wake_.notify_all();
+		}
+
+		worker_pool(worker_pool const& other) = delete;
+		auto operator=(worker_pool const& other) -> worker_pool& = delete;
+
+		[[nodiscard]] auto size() const noexcept -> std::size_t {
+			return size_;
+		}
+
+		// Splits [0, count) into blocks of grain indices, which workers claim dynamically, and
+		// calls fn(worker, first, last) for each block. worker is in [0, size()), so it can index
+		// per-thread scratch space. Returns once every block is done, rethrowing the first
+		// exception any block threw.
+		template<typename F>
+		auto for_each_block(std::size_t count, std::size_t grain, F&& fn) -> void {
+			if (count == 0) {
+				return;
+			}
+			grain = std::max(grain, std::size_t{1});
+			if (size_ == 1 or count <= grain) {
+				fn(std::size_t{0}, std::size_t{0}, count);
+				return;
+			}
+			next_.store(0, std::memory_order_relaxed);
+			job_ = [this, count, grain, &fn](std::size_t worker) {
+				for (;;) {
+					auto const first = next_.fetch_add(grain, std::memory_order_relaxed);
+					if (first >= count) {
+						return;
+					}
+					fn(worker, first, std::min(count, first + grain));
+				}
+			};
+			{
+				auto lock = std::lock_guard(mutex_);
+				active_ = size_ - 1;
+				error_ = nullptr;
+				++generation_;
+			}
+			wake_.notify_all();
+			run_job(0);
+			auto lock = std::unique_lock(mutex_);
+			done_.wait(lock, [this] { return active_ == 0; });
+			job_ = nullptr;
+			if (error_) {
+				std::rethrow_exception(error_);
+			}
+		}
+
+		// Calls fn(worker, i) for every i in [0, count).
+		template<typename F>
+		auto for_each(std::size_t count, F&& fn, std::size_t grain = 1024) -> void {
+			for_each_block(count, grain, [&fn](std::size_t worker, std::size_t first, std::size_t last) {
+				for (auto i = first; i < last; ++i) {
+					fn(worker, i);
+				}
+			});
+		}
+
+	 private:
+		auto serve(std::size_t worker) -> void {
+			auto seen = std::size_t{0};
+			for (;;) {
+				{
+					auto lock = std::unique_lock(mutex_);
+					wake_.wait(lock, [&] { return stopping_ or generation_ != seen; });
+					if (stopping_) {
+						return;
+					}
+					seen = generation_;
+				}
+				run_job(worker);
+				auto lock = std::lock_guard(mutex_);
+				if (--active_ == 0) {
+					done_.notify_one();
+				}
+			}
+		}
+
+		auto run_job(std::size_t worker) noexcept -> void {
+			try {
+				job_(worker);
+			} catch (...) {
+				auto lock = std::lock_guard(mutex_);
+				if (!error_) {
+					error_ = std::current_exception();
+				}
+				// Stop handing out blocks so the other workers finish quickly.
+				next_.store(static_cast<std::size_t>(-1) / 2, std::memory_order_relaxed);
+			}
+		}
+
+		std::size_t size_;
+		std::mutex mutex_;
+		std::condition_variable wake_;
+		std::condition_variable done_;
+		std::size_t generation_ = 0;
+		std::size_t active_ = 0;
+		bool stopping_ = false;
+		std::exception_ptr error_;
+		std::function<void(std::size_t)> job_;
+		std::atomic<std::size_t> next_ = 0;
+		// Declared last so the threads are joined before anything they use is destroyed.
+		std::vector<std::jthread> threads_;
+	};
+} // namespace gdwg
+
+#endif // GDWG_PARALLEL_H
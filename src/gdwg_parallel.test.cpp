@@ -0,0 +1,48 @@
+#include "gdwg_parallel.h"
+
+#include <catch2/catch.hpp>
+
+#include <atomic>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+
+TEST_CASE("Worker Pool - Visits Every Index Once") {
+	auto const threads = GENERATE(std::size_t{1}, std::size_t{4});
+	auto pool = gdwg::worker_pool(threads);
+	CHECK(pool.size() == threads);
+
+	for (auto const count : {std::size_t{0}, std::size_t{1}, std::size_t{1000}, std::size_t{100003}}) {
+		auto visits = std::vector<std::atomic<int>>(count);
+		auto workers_seen = std::vector<std::atomic<int>>(pool.size());
+		pool.for_each(
+		    count,
+		    [&](std::size_t worker, std::size_t i) {
+			    ++visits[i];
+			    ++workers_seen[worker];
+		    },
+		    64);
+		CHECK(std::all_of(visits.begin(), visits.end(), [](auto const& v) { return v.load() == 1; }));
+		auto total = 0;
+		for (auto const& seen : workers_seen) {
+			total += seen.load();
+		}
+		CHECK(total == static_cast<int>(count));
+	}
+}
+
+TEST_CASE("Worker Pool - Propagates Exceptions") {
+	auto pool = gdwg::worker_pool(3);
+	CHECK_THROWS_AS(pool.for_each(10000,
+	                              [](std::size_t, std::size_t i) {
+		                              if (i == 5000) {
+			                              throw std::runtime_error("block failed");
+		                              }
+	                              }),
+	                std::runtime_error);
+
+	// The pool is still usable afterwards.
+	auto sum = std::atomic<std::size_t>{0};
+	pool.for_each(100, [&](std::size_t, std::size_t i) { sum += i; });
+	CHECK(sum == 4950);
+}
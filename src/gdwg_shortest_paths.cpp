@@ -0,0 +1 @@
+#include "gdwg_shortest_paths.h"
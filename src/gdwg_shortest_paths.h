@@ -0,0 +1,689 @@
+#ifndef GDWG_SHORTEST_PATHS_H
+#define GDWG_SHORTEST_PATHS_H
+
+#include "gdwg_graph.h"
+#include "gdwg_parallel.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <limits>
+#include <map>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace gdwg {
+	// The distance of a node no path reaches.
+	template<typename E>
+	inline constexpr auto infinite_distance =
+	    std::numeric_limits<E>::has_infinity ? std::numeric_limits<E>::infinity() : std::numeric_limits<E>::max();
+
+	// Distances and predecessors from one source, indexed by the graph's dense node ids.
+	template<typename E>
+	struct shortest_path_tree {
+		using node_id = std::uint32_t;
+		static constexpr auto no_node = std::numeric_limits<node_id>::max();
+
+		node_id source = no_node;
+		std::vector<E> distances;
+		std::vector<node_id> predecessors;
+		// Nodes whose distance was finalised, which is how much of the graph a search explored.
+		std::size_t settled = 0;
+
+		[[nodiscard]] auto reached(node_id id) const -> bool {
+			return distances[id] != infinite_distance<E>;
+		}
+
+		// The nodes on the shortest path from source to target inclusive, or nothing if target is
+		// unreachable.
+		[[nodiscard]] auto path_to(node_id target) const -> std::vector<node_id> {
+			auto path = std::vector<node_id>{};
+			if (!reached(target)) {
+				return path;
+			}
+			for (auto id = target; id != no_node; id = predecessors[id]) {
+				path.push_back(id);
+			}
+			std::reverse(path.begin(), path.end());
+			return path;
+		}
+	};
+
+	enum class heap_kind { binary, pairing, radix };
+
+	template<typename E>
+	struct dijkstra_options {
+		// The cost of traversing an unweighted edge.
+		E unweighted_cost = E{1};
+		heap_kind heap = heap_kind::binary;
+	};
+
+	template<typename E>
+	struct delta_stepping_options {
+		// The cost of traversing an unweighted edge.
+		E unweighted_cost = E{1};
+		// The width of each distance bucket. Edges no longer than this are light and are relaxed
+		// repeatedly within a bucket; the rest are heavy and relaxed once per bucket. Unset picks the
+		// largest edge cost divided by the average out-degree.
+		std::optional<E> delta = std::nullopt;
+		// Threads used when no worker_pool is supplied. Zero uses every hardware thread.
+		std::size_t threads = 0;
+	};
+
+	namespace detail {
+		template<typename E, typename Record>
+		auto edge_cost(Record const& record, E const& unweighted_cost) -> E {
+			return record.weight ? *record.weight : unweighted_cost;
+		}
+
+		template<typename E>
+		auto check_non_negative(E const& cost, char const* function) -> void {
+			if constexpr (std::is_signed_v<E>) {
+				if (cost < E{0}) {
+					throw std::runtime_error(std::string("Cannot call ") + function
+					                         + " on a graph with negative edge weights");
+				}
+			}
+		}
+
+		// Each heap queues node ids by key. push() either inserts id or lowers its key, and pop()
+		// removes an id with the smallest key. The binary and radix heaps handle a lowered key by
+		// queueing id again, so pop() may return an id that has already been popped.
+		template<typename Key>
+		class binary_heap {
+		 public:
+			explicit binary_heap(std::size_t) {}
+
+			auto push(std::uint32_t id, Key key) -> void {
+				entries_.emplace_back(key, id);
+				std::push_heap(entries_.begin(), entries_.end(), std::greater<>{});
+			}
+
+			auto pop() -> std::uint32_t {
+				std::pop_heap(entries_.begin(), entries_.end(), std::greater<>{});
+				auto const id = entries_.back().second;
+				entries_.pop_back();
+				return id;
+			}
+
+			[[nodiscard]] auto empty() const noexcept -> bool {
+				return entries_.empty();
+			}
+
+		 private:
+			std::vector<std::pair<Key, std::uint32_t>> entries_;
+		};
+
+		// A pairing heap with true decrease-key, stored as flat per-id arrays. prev_ holds the parent
+		// of a first child and the left sibling of any other child.
+		template<typename Key>
+		class pairing_heap {
+		 public:
+			explicit pairing_heap(std::size_t node_count)
+			: key_(node_count)
+			, child_(node_count, none)
+			, next_(node_count, none)
+			, prev_(node_count, none)
+			, queued_(node_count, false) {}
+
+			auto push(std::uint32_t id, Key key) -> void {
+				if (queued_[id]) {
+					if (!(key < key_[id])) {
+						return;
+					}
+					key_[id] = key;
+					if (id == root_) {
+						return;
+					}
+					detach(id);
+				}
+				else {
+					queued_[id] = true;
+					key_[id] = key;
+					child_[id] = none;
+				}
+				root_ = root_ == none ? id : meld(root_, id);
+			}
+
+			auto pop() -> std::uint32_t {
+				auto const top = root_;
+				queued_[top] = false;
+				children_.clear();
+				for (auto c = child_[top]; c != none;) {
+					auto const next = next_[c];
+					next_[c] = prev_[c] = none;
+					children_.push_back(c);
+					c = next;
+				}
+				// Two-pass pairing: meld neighbours left to right, then fold the pairs right to left.
+				auto pairs = std::size_t{0};
+				for (auto i = std::size_t{0}; i < children_.size(); i += 2) {
+					children_[pairs++] = i + 1 < children_.size() ? meld(children_[i], children_[i + 1]) : children_[i];
+				}
+				root_ = none;
+				while (pairs > 0) {
+					auto const tree = children_[--pairs];
+					root_ = root_ == none ? tree : meld(tree, root_);
+				}
+				return top;
+			}
+
+			[[nodiscard]] auto empty() const noexcept -> bool {
+				return root_ == none;
+			}
+
+		 private:
+			static constexpr auto none = std::numeric_limits<std::uint32_t>::max();
+
+			// Links two roots, making the one with the larger key the first child of the other.
+			auto meld(std::uint32_t a, std::uint32_t b) -> std::uint32_t {
+				if (key_[b] < key_[a]) {
+					std::swap(a, b);
+				}
+				next_[b] = child_[a];
+				if (child_[a] != none) {
+					prev_[child_[a]] = b;
+				}
+				prev_[b] = a;
+				child_[a] = b;
+				return a;
+			}
+
+			auto detach(std::uint32_t id) -> void {
+				auto const prev = prev_[id];
+				if (child_[prev] == id) {
+					child_[prev] = next_[id];
+				}
+				else {
+					next_[prev] = next_[id];
+				}
+				if (next_[id] != none) {
+					prev_[next_[id]] = prev;
+				}
+				next_[id] = prev_[id] = none;
+			}
+
+			std::vector<Key> key_;
+			std::vector<std::uint32_t> child_;
+			std::vector<std::uint32_t> next_;
+			std::vector<std::uint32_t> prev_;
+			std::vector<bool> queued_;
+			std::vector<std::uint32_t> children_;
+			std::uint32_t root_ = none;
+		};
+
+		template<typename E>
+		inline constexpr auto radix_keyable = std::is_integral_v<E>
+		                                      or (std::is_floating_point_v<E> and (sizeof(E) == 4 or sizeof(E) == 8));
+
+		// Maps a non-negative distance to an unsigned key with the same order. Non-negative IEEE
+		// floats already order like their bit patterns.
+		template<typename E>
+		auto radix_key(E value) noexcept -> std::uint64_t {
+			if constexpr (std::is_integral_v<E>) {
+				return static_cast<std::uint64_t>(value);
+			}
+			else if constexpr (sizeof(E) == 4) {
+				return std::bit_cast<std::uint32_t>(value);
+			}
+			else {
+				return std::bit_cast<std::uint64_t>(value);
+			}
+		}
+
+		// A monotone radix heap. Keys may never be smaller than the last key popped, which holds for
+		// Dijkstra with non-negative weights. Bucket i holds keys whose highest bit differing from
+		// the last popped key is bit i - 1, so each entry moves down at most 64 times in total.
+		template<typename E>
+		class radix_heap {
+		 public:
+			explicit radix_heap(std::size_t) {}
+
+			auto push(std::uint32_t id, E value) -> void {
+				auto const key = radix_key(value);
+				buckets_[bucket_of(key)].emplace_back(key, id);
+				++size_;
+			}
+
+			auto pop() -> std::uint32_t {
+				if (buckets_[0].empty()) {
+					auto i = std::size_t{1};
+					while (buckets_[i].empty()) {
+						++i;
+					}
+					last_ = std::min_element(buckets_[i].begin(), buckets_[i].end())->first;
+					for (auto const& entry : buckets_[i]) {
+						buckets_[bucket_of(entry.first)].push_back(entry);
+					}
+					buckets_[i].clear();
+				}
+				auto const id = buckets_[0].back().second;
+				buckets_[0].pop_back();
+				--size_;
+				return id;
+			}
+
+			[[nodiscard]] auto empty() const noexcept -> bool {
+				return size_ == 0;
+			}
+
+		 private:
+			auto bucket_of(std::uint64_t key) const noexcept -> std::size_t {
+				return static_cast<std::size_t>(std::bit_width(key ^ last_));
+			}
+
+			std::array<std::vector<std::pair<std::uint64_t, std::uint32_t>>, 65> buckets_;
+			std::uint64_t last_ = 0;
+			std::size_t size_ = 0;
+		};
+
+		template<typename Heap, typename N, typename E>
+		auto run_dijkstra(graph<N, E> const& g,
+		                  std::uint32_t source,
+		                  std::optional<std::uint32_t> target,
+		                  dijkstra_options<E> const& options) -> shortest_path_tree<E> {
+			auto tree = shortest_path_tree<E>{};
+			tree.source = source;
+			tree.distances.assign(g.node_count(), infinite_distance<E>);
+			tree.predecessors.assign(g.node_count(), shortest_path_tree<E>::no_node);
+			auto settled = std::vector<bool>(g.node_count(), false);
+			auto heap = Heap(g.node_count());
+			tree.distances[source] = E{0};
+			heap.push(source, E{0});
+			while (!heap.empty()) {
+				auto const u = heap.pop();
+				if (settled[u]) {
+					continue;
+				}
+				settled[u] = true;
+				++tree.settled;
+				if (target == u) {
+					break;
+				}
+				auto const du = tree.distances[u];
+				for (auto const& record : g.out_edges(u)) {
+					auto const cost = edge_cost(record, options.unweighted_cost);
+					check_non_negative(cost, "gdwg::dijkstra");
+					auto const candidate = du + cost;
+					if (candidate < tree.distances[record.dst]) {
+						tree.distances[record.dst] = candidate;
+						tree.predecessors[record.dst] = u;
+						heap.push(record.dst, candidate);
+					}
+				}
+			}
+			return tree;
+		}
+	} // namespace detail
+
+	namespace detail {
+		template<typename N, typename E>
+		auto dijkstra_with_heap(graph<N, E> const& g,
+		                        std::uint32_t source,
+		                        std::optional<std::uint32_t> target,
+		                        dijkstra_options<E> const& options) -> shortest_path_tree<E> {
+			switch (options.heap) {
+			case heap_kind::pairing: return run_dijkstra<pairing_heap<E>>(g, source, target, options);
+			case heap_kind::radix:
+				if constexpr (radix_keyable<E>) {
+					return run_dijkstra<radix_heap<E>>(g, source, target, options);
+				}
+				[[fallthrough]];
+			case heap_kind::binary: break;
+			}
+			return run_dijkstra<binary_heap<E>>(g, source, target, options);
+		}
+	} // namespace detail
+
+	// Single-source shortest paths over non-negative edge costs, reading each node's edges in
+	// place from the graph. The result is indexed by the graph's dense node ids. Unweighted edges
+	// cost options.unweighted_cost. Throws std::runtime_error if a negative cost is reached. The
+	// radix heap needs integral or float/double costs and falls back to the binary heap otherwise.
+	template<typename N, typename E>
+	requires std::is_arithmetic_v<E>
+	auto dijkstra(graph<N, E> const& g, std::type_identity_t<N> const& source, dijkstra_options<E> const& options = {})
+	    -> shortest_path_tree<E> {
+		auto const src =
+		    detail::id_or_throw(g, source, "Cannot call gdwg::dijkstra if source doesn't exist in the graph");
+		return detail::dijkstra_with_heap(g, src, std::nullopt, options);
+	}
+
+	// Stops as soon as target is settled, so only target's distance and path in the result are final.
+	template<typename N, typename E>
+	requires std::is_arithmetic_v<E>
+	auto dijkstra(graph<N, E> const& g,
+	              std::type_identity_t<N> const& source,
+	              std::type_identity_t<N> const& target,
+	              dijkstra_options<E> const& options = {}) -> shortest_path_tree<E> {
+		auto const src =
+		    detail::id_or_throw(g, source, "Cannot call gdwg::dijkstra if source doesn't exist in the graph");
+		auto const dst =
+		    detail::id_or_throw(g, target, "Cannot call gdwg::dijkstra if target doesn't exist in the graph");
+		return detail::dijkstra_with_heap(g, src, dst, options);
+	}
+
+	namespace detail {
+		template<typename N, typename E>
+		auto choose_delta(graph<N, E> const& g, E const& unweighted_cost) -> E {
+			auto longest = E{0};
+			for (auto u = std::uint32_t{0}; u < g.node_count(); ++u) {
+				for (auto const& record : g.out_edges(u)) {
+					auto const cost = edge_cost(record, unweighted_cost);
+					check_non_negative(cost, "gdwg::delta_stepping");
+					longest = std::max(longest, cost);
+				}
+			}
+			if (g.edge_count() == 0) {
+				return E{1};
+			}
+			// In double, since longest * node_count can overflow an integral E.
+			auto const delta = static_cast<double>(longest) * static_cast<double>(g.node_count())
+			                   / static_cast<double>(g.edge_count());
+			if (delta >= static_cast<double>(std::numeric_limits<E>::max())) {
+				return std::numeric_limits<E>::max();
+			}
+			auto const rounded = static_cast<E>(delta);
+			return rounded > E{0} ? rounded : E{1};
+		}
+	} // namespace detail
+
+	// Parallel single-source shortest paths by delta-stepping. The result matches dijkstra's
+	// distances exactly. Among equally short paths the predecessor chosen may differ, but it
+	// always lies on a shortest path. Relaxations within a phase run on pool's workers and
+	// lower distances with atomic compare-and-swap. Between phases the calling thread moves the
+	// improved nodes into their new buckets and records their predecessors. Throws
+	// std::runtime_error for an unknown source, a non-positive delta or a negative edge cost.
+	template<typename N, typename E>
+	requires std::is_arithmetic_v<E>
+	auto delta_stepping(graph<N, E> const& g,
+	                    std::type_identity_t<N> const& source,
+	                    worker_pool& pool,
+	                    delta_stepping_options<E> const& options = {}) -> shortest_path_tree<E> {
+		using node_id = std::uint32_t;
+		auto const src = detail::id_or_throw(g,
+		                                     source,
+		                                     "Cannot call gdwg::delta_stepping if source doesn't exist in the graph");
+		auto const delta = options.delta ? *options.delta : detail::choose_delta(g, options.unweighted_cost);
+		if (!(delta > E{0})) {
+			throw std::runtime_error("Cannot call gdwg::delta_stepping with a non-positive delta");
+		}
+		auto const bucket_of = [delta](E distance) { return static_cast<std::size_t>(distance / delta); };
+
+		struct update {
+			node_id node;
+			node_id predecessor;
+			E distance;
+		};
+		auto const n = g.node_count();
+		auto distances = std::vector<std::atomic<E>>(n);
+		for (auto& distance : distances) {
+			distance.store(infinite_distance<E>, std::memory_order_relaxed);
+		}
+		auto tree = shortest_path_tree<E>{};
+		tree.source = src;
+		tree.predecessors.assign(n, shortest_path_tree<E>::no_node);
+		auto updates = std::vector<std::vector<update>>(pool.size());
+		auto buckets = std::map<std::size_t, std::vector<node_id>>{};
+		auto queued = std::vector<bool>(n, false);
+		auto frontier = std::vector<node_id>{};
+		auto bucket_nodes = std::vector<node_id>{};
+
+		// Relaxes the light or the heavy edges of every node in nodes, then buckets the improvements.
+		auto relax = [&](std::vector<node_id> const& nodes, bool light) {
+			pool.for_each_block(nodes.size(), 256, [&](std::size_t worker, std::size_t first, std::size_t last) {
+				for (auto i = first; i < last; ++i) {
+					auto const u = nodes[i];
+					auto const du = distances[u].load(std::memory_order_relaxed);
+					for (auto const& record : g.out_edges(u)) {
+						auto const cost = detail::edge_cost(record, options.unweighted_cost);
+						detail::check_non_negative(cost, "gdwg::delta_stepping");
+						if ((cost <= delta) != light) {
+							continue;
+						}
+						auto const candidate = du + cost;
+						auto& target = distances[record.dst];
+						auto current = target.load(std::memory_order_relaxed);
+						while (candidate < current) {
+							if (target.compare_exchange_weak(current, candidate, std::memory_order_relaxed)) {
+								updates[worker].push_back({record.dst, u, candidate});
+								break;
+							}
+						}
+					}
+				}
+			});
+			// Distances only fall, so of all successful updates to a node exactly one carries its
+			// final distance for this phase.
+			for (auto& worker_updates : updates) {
+				for (auto const& [node, predecessor, distance] : worker_updates) {
+					if (distances[node].load(std::memory_order_relaxed) == distance) {
+						tree.predecessors[node] = predecessor;
+						buckets[bucket_of(distance)].push_back(node);
+					}
+				}
+				worker_updates.clear();
+			}
+		};
+
+		distances[src].store(E{0}, std::memory_order_relaxed);
+		buckets[0].push_back(src);
+		while (!buckets.empty()) {
+			auto const current = buckets.begin()->first;
+			bucket_nodes.clear();
+			for (auto it = buckets.find(current); it != buckets.end(); it = buckets.find(current)) {
+				frontier.clear();
+				for (auto v : it->second) {
+					if (!queued[v] and bucket_of(distances[v].load(std::memory_order_relaxed)) == current) {
+						queued[v] = true;
+						frontier.push_back(v);
+					}
+				}
+				buckets.erase(it);
+				for (auto v : frontier) {
+					queued[v] = false;
+				}
+				bucket_nodes.insert(bucket_nodes.end(), frontier.begin(), frontier.end());
+				relax(frontier, true);
+			}
+			std::sort(bucket_nodes.begin(), bucket_nodes.end());
+			bucket_nodes.erase(std::unique(bucket_nodes.begin(), bucket_nodes.end()), bucket_nodes.end());
+			relax(bucket_nodes, false);
+		}
+
+		tree.distances.reserve(n);
+		for (auto const& distance : distances) {
+			tree.distances.push_back(distance.load(std::memory_order_relaxed));
+			if (tree.distances.back() != infinite_distance<E>) {
+				++tree.settled;
+			}
+		}
+		return tree;
+	}
+
+	template<typename N, typename E>
+	requires std::is_arithmetic_v<E>
+	auto delta_stepping(graph<N, E> const& g,
+	                    std::type_identity_t<N> const& source,
+	                    delta_stepping_options<E> const& options = {}) -> shortest_path_tree<E> {
+		auto pool = worker_pool(options.threads);
+		return delta_stepping(g, source, pool, options);
+	}
+
+	// The result of bellman_ford: shortest paths, or a negative cycle proving there are none.
+	template<typename E>
+	struct bellman_ford_result {
+		// Final only if there is no negative cycle.
+		shortest_path_tree<E> tree;
+		// The dense node ids of one negative cycle in edge order, each with an edge to the next and
+		// the last with an edge back to the first; g.node(id) gives their values, like the tree's
+		// indices. Empty if no negative cycle is reachable.
+		std::vector<std::uint32_t> negative_cycle;
+
+		[[nodiscard]] auto has_negative_cycle() const noexcept -> bool {
+			return !negative_cycle.empty();
+		}
+	};
+
+	namespace detail {
+		// Out-edges in flat arrays, with parallel edges between the same pair merged into the
+		// cheapest. The edges leaving u occupy [offsets[u], offsets[u + 1]) of heads and costs.
+		template<typename E>
+		struct cheapest_edges {
+			std::vector<std::size_t> offsets;
+			std::vector<std::uint32_t> heads;
+			std::vector<E> costs;
+		};
+
+		template<typename N, typename E>
+		auto make_cheapest_edges(graph<N, E> const& g, E const& unweighted_cost) -> cheapest_edges<E> {
+			auto const n = g.node_count();
+			auto edges = cheapest_edges<E>{};
+			edges.offsets.assign(n + 1, 0);
+			edges.heads.reserve(g.edge_count());
+			edges.costs.reserve(g.edge_count());
+			for (auto u = std::uint32_t{0}; u < n; ++u) {
+				// Records are sorted by destination, so parallel edges are adjacent.
+				for (auto const& record : g.out_edges(u)) {
+					auto const cost = edge_cost(record, unweighted_cost);
+					if (edges.heads.size() > edges.offsets[u] and edges.heads.back() == record.dst) {
+						edges.costs.back() = std::min(edges.costs.back(), cost);
+						continue;
+					}
+					edges.heads.push_back(record.dst);
+					edges.costs.push_back(cost);
+				}
+				edges.offsets[u + 1] = edges.heads.size();
+			}
+			return edges;
+		}
+
+		// Queue-based Bellman-Ford (SPFA) from every node in sources at distance zero. With the
+		// small-label-first heuristic, a node whose new distance is below the front's joins the front
+		// of the queue instead of the back. Each node counts the edges on the path that gave its
+		// distance; a count of n means the path repeats a node, so a negative cycle exists. From then
+		// on the whole predecessor graph is searched for a cycle once every n relaxations, which keeps
+		// the O(n) search amortised O(1) per relaxation, and any cycle found stops the search.
+		template<typename E>
+		auto spfa(cheapest_edges<E> const& edges, std::vector<std::uint32_t> const& sources) -> bellman_ford_result<E> {
+			using node_id = std::uint32_t;
+			constexpr auto no_node = shortest_path_tree<E>::no_node;
+			auto const n = edges.offsets.size() - 1;
+			auto result = bellman_ford_result<E>{};
+			auto& tree = result.tree;
+			tree.source = sources.size() == 1 ? sources.front() : no_node;
+			tree.distances.assign(n, infinite_distance<E>);
+			tree.predecessors.assign(n, no_node);
+			auto lengths = std::vector<std::size_t>(n, 0);
+			auto queued = std::vector<char>(n, 0);
+			auto queue = std::deque<node_id>{};
+			for (auto source : sources) {
+				tree.distances[source] = E{0};
+				queued[source] = 1;
+				queue.push_back(source);
+			}
+
+			// Walks predecessors from every node in turn, marking each walk with its starting node, and
+			// returns the first cycle a walk closes on itself.
+			auto walked = std::vector<node_id>(n, no_node);
+			auto const find_cycle = [&]() -> std::vector<node_id> {
+				std::fill(walked.begin(), walked.end(), no_node);
+				for (auto start = node_id{0}; start < n; ++start) {
+					auto v = start;
+					for (; v != no_node and walked[v] == no_node; v = tree.predecessors[v]) {
+						walked[v] = start;
+					}
+					if (v == no_node or walked[v] != start) {
+						continue;
+					}
+					auto cycle = std::vector<node_id>{v};
+					for (auto w = tree.predecessors[v]; w != v; w = tree.predecessors[w]) {
+						cycle.push_back(w);
+					}
+					// The walk followed edges backwards.
+					std::reverse(cycle.begin(), cycle.end());
+					return cycle;
+				}
+				return {};
+			};
+			auto suspect = false;
+			auto relaxations = std::size_t{0};
+
+			while (!queue.empty()) {
+				auto const u = queue.front();
+				queue.pop_front();
+				queued[u] = 0;
+				for (auto a = edges.offsets[u]; a < edges.offsets[u + 1]; ++a) {
+					auto const v = edges.heads[a];
+					auto const candidate = tree.distances[u] + edges.costs[a];
+					if (!(candidate < tree.distances[v])) {
+						continue;
+					}
+					tree.distances[v] = candidate;
+					tree.predecessors[v] = u;
+					lengths[v] = lengths[u] + 1;
+					suspect = suspect or lengths[v] >= n;
+					if (suspect and ++relaxations >= n) {
+						relaxations = 0;
+						result.negative_cycle = find_cycle();
+						if (result.has_negative_cycle()) {
+							return result;
+						}
+					}
+					if (queued[v] != 0) {
+						continue;
+					}
+					queued[v] = 1;
+					if (!queue.empty() and candidate < tree.distances[queue.front()]) {
+						queue.push_front(v);
+					}
+					else {
+						queue.push_back(v);
+					}
+				}
+			}
+			tree.settled = static_cast<std::size_t>(
+			    std::count_if(tree.distances.begin(), tree.distances.end(), [](E const& distance) {
+				    return distance != infinite_distance<E>;
+			    }));
+			return result;
+		}
+	} // namespace detail
+
+	// Single-source shortest paths with negative edge costs allowed, by SPFA over flat per-id
+	// arrays. Parallel edges count at their cheapest and unweighted edges cost unweighted_cost.
+	// If a negative cycle is reachable from source, returns one instead of final distances.
+	// Throws std::runtime_error if source is not a node.
+	template<typename N, typename E>
+	requires std::is_arithmetic_v<E>
+	auto bellman_ford(graph<N, E> const& g,
+	                  std::type_identity_t<N> const& source,
+	                  std::type_identity_t<E> const& unweighted_cost = E{1}) -> bellman_ford_result<E> {
+		auto const src =
+		    detail::id_or_throw(g, source, "Cannot call gdwg::bellman_ford if source doesn't exist in the graph");
+		return detail::spfa(detail::make_cheapest_edges(g, unweighted_cost), {src});
+	}
+
+	// A negative cycle anywhere in g, reachable or not, as node ids in edge order, or nothing if
+	// there is none. Searches from every node at once.
+	template<typename N, typename E>
+	requires std::is_arithmetic_v<E>
+	auto find_negative_cycle(graph<N, E> const& g, std::type_identity_t<E> const& unweighted_cost = E{1})
+	    -> std::vector<std::uint32_t> {
+		auto sources = std::vector<std::uint32_t>(g.node_count());
+		for (auto v = std::uint32_t{0}; v < g.node_count(); ++v) {
+			sources[v] = v;
+		}
+		return detail::spfa(detail::make_cheapest_edges(g, unweighted_cost), sources).negative_cycle;
+	}
+} // namespace gdwg
+
+#endif // GDWG_SHORTEST_PATHS_H
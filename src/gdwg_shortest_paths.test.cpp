@@ -0,0 +1,372 @@
+#include "gdwg_shortest_paths.h"
+
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+#include <optional>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+	// Repeatedly relaxes every edge until nothing changes.
+	template<typename N, typename E>
+	auto reference_distances(gdwg::graph<N, E> const& g, N const& source, E unweighted_cost) -> std::vector<E> {
+		auto distances = std::vector<E>(g.node_count(), gdwg::infinite_distance<E>);
+		distances[*g.id_of(source)] = E{0};
+		for (auto changed = true; changed;) {
+			changed = false;
+			for (auto const& [from, to, weight] : g) {
+				auto const u = *g.id_of(from);
+				auto const v = *g.id_of(to);
+				if (distances[u] == gdwg::infinite_distance<E>) {
+					continue;
+				}
+				if (auto const candidate = distances[u] + weight.value_or(unweighted_cost); candidate < distances[v]) {
+					distances[v] = candidate;
+					changed = true;
+				}
+			}
+		}
+		return distances;
+	}
+
+	template<typename E>
+	auto random_graph(unsigned seed, int nodes, int edges) -> gdwg::graph<int, E> {
+		auto engine = std::mt19937(seed);
+		auto node = std::uniform_int_distribution<int>(0, nodes - 1);
+		auto weight = std::uniform_int_distribution<int>(0, 100);
+		auto g = gdwg::graph<int, E>{};
+		for (auto i = 0; i < nodes; ++i) {
+			g.insert_node(i);
+		}
+		for (auto i = 0; i < edges; ++i) {
+			if (i % 10 == 0) {
+				g.insert_edge(node(engine), node(engine));
+			}
+			else {
+				g.insert_edge(node(engine), node(engine), static_cast<E>(weight(engine)) / E{4});
+			}
+		}
+		return g;
+	}
+} // namespace
+
+TEST_CASE("Dijkstra - Small Graph") {
+	auto g = gdwg::graph<std::string, int>{"a", "b", "c", "d", "e"};
+	g.insert_edge("a", "b", 4);
+	g.insert_edge("a", "c", 1);
+	g.insert_edge("c", "b", 2);
+	g.insert_edge("b", "d", 1);
+	g.insert_edge("b", "d", 7);
+	g.insert_edge("c", "d");
+
+	auto const heap = GENERATE(gdwg::heap_kind::binary, gdwg::heap_kind::pairing, gdwg::heap_kind::radix);
+	auto options = gdwg::dijkstra_options<int>{};
+	options.heap = heap;
+
+	SECTION("Unweighted edges cost one by default") {
+		auto const tree = gdwg::dijkstra(g, "a", options);
+		CHECK(tree.distances[*g.id_of("b")] == 3);
+		CHECK(tree.distances[*g.id_of("d")] == 2);
+		CHECK(!tree.reached(*g.id_of("e")));
+		CHECK(tree.path_to(*g.id_of("e")).empty());
+
+		auto path = std::vector<std::string>{};
+		for (auto id : tree.path_to(*g.id_of("d"))) {
+			path.push_back(g.node(id));
+		}
+		CHECK(path == std::vector<std::string>{"a", "c", "d"});
+	}
+
+	SECTION("Configurable unweighted cost") {
+		options.unweighted_cost = 10;
+		auto const tree = gdwg::dijkstra(g, "a", options);
+		CHECK(tree.distances[*g.id_of("d")] == 4);
+		CHECK(tree.predecessors[*g.id_of("d")] == *g.id_of("b"));
+	}
+}
+
+TEST_CASE("Dijkstra - Heaps Match Reference") {
+	auto const g = random_graph<double>(5, 400, 3000);
+	auto const expected = reference_distances(g, 0, 1.0);
+	auto const heap = GENERATE(gdwg::heap_kind::binary, gdwg::heap_kind::pairing, gdwg::heap_kind::radix);
+	auto options = gdwg::dijkstra_options<double>{};
+	options.heap = heap;
+	auto const tree = gdwg::dijkstra(g, 0, options);
+	CHECK(tree.distances == expected);
+
+	// Every predecessor lies on a shortest path.
+	for (auto v = std::uint32_t{0}; v < g.node_count(); ++v) {
+		auto const u = tree.predecessors[v];
+		if (u == tree.no_node) {
+			continue;
+		}
+		auto const edges = g.out_edges(u);
+		CHECK(std::any_of(edges.begin(), edges.end(), [&](auto const& e) {
+			return e.dst == v and tree.distances[u] + e.weight.value_or(1.0) == tree.distances[v];
+		}));
+	}
+}
+
+TEST_CASE("Dijkstra - Early Exit At Target") {
+	auto const g = random_graph<unsigned>(9, 2000, 8000);
+	auto const full = gdwg::dijkstra(g, 0);
+	auto const target = GENERATE(1, 17, 512);
+	auto const heap = GENERATE(gdwg::heap_kind::binary, gdwg::heap_kind::pairing, gdwg::heap_kind::radix);
+	auto options = gdwg::dijkstra_options<unsigned>{};
+	options.heap = heap;
+	auto const tree = gdwg::dijkstra(g, 0, target, options);
+	auto const id = *g.id_of(target);
+	CHECK(tree.distances[id] == full.distances[id]);
+	CHECK(tree.path_to(id).size() == full.path_to(id).size());
+	CHECK(tree.settled <= full.settled);
+}
+
+TEST_CASE("Dijkstra - Errors") {
+	auto g = gdwg::graph<int, int>{1, 2};
+	CHECK_THROWS_MATCHES(gdwg::dijkstra(g, 3),
+	                     std::runtime_error,
+	                     Catch::Matchers::Message("Cannot call gdwg::dijkstra if source doesn't exist in the graph"));
+	CHECK_THROWS_MATCHES(gdwg::dijkstra(g, 1, 3),
+	                     std::runtime_error,
+	                     Catch::Matchers::Message("Cannot call gdwg::dijkstra if target doesn't exist in the graph"));
+	g.insert_edge(1, 2, -1);
+	CHECK_THROWS_MATCHES(gdwg::dijkstra(g, 1),
+	                     std::runtime_error,
+	                     Catch::Matchers::Message("Cannot call gdwg::dijkstra on a graph with negative edge weights"));
+}
+
+namespace {
+	// An R-MAT graph on 2^scale nodes, whose skewed degrees resemble real networks.
+	template<typename E>
+	auto rmat_graph(unsigned seed, int scale, int edges, int max_weight) -> gdwg::graph<int, E> {
+		auto engine = std::mt19937(seed);
+		auto quadrant = std::uniform_real_distribution<double>(0, 1);
+		auto weight = std::uniform_int_distribution<int>(0, max_weight);
+		auto g = gdwg::graph<int, E>{};
+		for (auto i = 0; i < (1 << scale); ++i) {
+			g.insert_node(i);
+		}
+		auto batch = std::vector<std::tuple<int, int, std::optional<E>>>{};
+		for (auto i = 0; i < edges; ++i) {
+			auto src = 0;
+			auto dst = 0;
+			for (auto bit = 0; bit < scale; ++bit) {
+				auto const r = quadrant(engine);
+				src = src * 2 + (r >= 0.57 + 0.19 ? 1 : 0);
+				dst = dst * 2 + ((r >= 0.57 and r < 0.76) or r >= 0.95 ? 1 : 0);
+			}
+			batch.emplace_back(src, dst, static_cast<E>(weight(engine)));
+		}
+		g.insert_edges(batch);
+		return g;
+	}
+
+	template<typename N, typename E>
+	auto check_predecessors(gdwg::graph<N, E> const& g, gdwg::shortest_path_tree<E> const& tree) -> void {
+		for (auto v = std::uint32_t{0}; v < g.node_count(); ++v) {
+			auto const u = tree.predecessors[v];
+			if (u == tree.no_node) {
+				CHECK((v == tree.source or !tree.reached(v)));
+				continue;
+			}
+			auto const edges = g.out_edges(u);
+			CHECK(std::any_of(edges.begin(), edges.end(), [&](auto const& e) {
+				return e.dst == v and tree.distances[u] + e.weight.value_or(E{1}) == tree.distances[v];
+			}));
+			CHECK(tree.path_to(v).size() <= g.node_count());
+		}
+	}
+} // namespace
+
+TEST_CASE("Delta Stepping - Matches Dijkstra") {
+	auto const threads = GENERATE(std::size_t{1}, std::size_t{4});
+	auto pool = gdwg::worker_pool(threads);
+
+	SECTION("Integral weights on an R-MAT graph, including zero weights") {
+		auto const g = rmat_graph<int>(3, 10, 8000, 20);
+		auto const expected = gdwg::dijkstra(g, 0);
+		auto options = gdwg::delta_stepping_options<int>{};
+		options.delta =
+		    GENERATE(std::optional<int>{}, std::optional<int>{1}, std::optional<int>{7}, std::optional<int>{1000});
+		auto const tree = gdwg::delta_stepping(g, 0, pool, options);
+		CHECK(tree.distances == expected.distances);
+		CHECK(tree.settled == expected.settled);
+		check_predecessors(g, tree);
+	}
+
+	SECTION("Large integral weights on a sparse graph") {
+		// The default delta, longest * node_count / edge_count, is far beyond int here.
+		auto g = gdwg::graph<int, int>{};
+		for (auto i = 0; i < 1000; ++i) {
+			g.insert_node(i);
+		}
+		for (auto i = 0; i < 10; ++i) {
+			g.insert_edge(i, i + 1, 200'000'000);
+			g.insert_edge(i, i + 500, 150'000'000);
+		}
+		auto const expected = gdwg::dijkstra(g, 0);
+		auto const tree = gdwg::delta_stepping(g, 0, pool);
+		CHECK(tree.distances == expected.distances);
+		check_predecessors(g, tree);
+	}
+
+	SECTION("Floating weights with unweighted edges") {
+		auto const g = random_graph<double>(21, 1500, 9000);
+		auto const expected = gdwg::dijkstra(g, 3);
+		auto options = gdwg::delta_stepping_options<double>{};
+		options.delta = GENERATE(std::optional<double>{}, std::optional<double>{0.5}, std::optional<double>{40.0});
+		auto const tree = gdwg::delta_stepping(g, 3, pool, options);
+		CHECK(tree.distances == expected.distances);
+		check_predecessors(g, tree);
+	}
+}
+
+TEST_CASE("Delta Stepping - Errors") {
+	auto g = gdwg::graph<int, int>{1, 2};
+	CHECK_THROWS_MATCHES(gdwg::delta_stepping(g, 3),
+	                     std::runtime_error,
+	                     Catch::Matchers::Message("Cannot call gdwg::delta_stepping if source doesn't exist in the "
+	                                              "graph"));
+	auto options = gdwg::delta_stepping_options<int>{};
+	options.delta = 0;
+	CHECK_THROWS_MATCHES(gdwg::delta_stepping(g, 1, options),
+	                     std::runtime_error,
+	                     Catch::Matchers::Message("Cannot call gdwg::delta_stepping with a non-positive delta"));
+	g.insert_edge(1, 2, -1);
+	options.threads = 2;
+	options.delta = 4;
+	CHECK_THROWS_MATCHES(gdwg::delta_stepping(g, 1, options),
+	                     std::runtime_error,
+	                     Catch::Matchers::Message("Cannot call gdwg::delta_stepping on a graph with negative edge "
+	                                              "weights"));
+}
+
+namespace {
+	// Weights that may be negative but cancel around every cycle less than their non-negative base.
+	auto potential_graph(unsigned seed, int nodes, int edges) -> gdwg::graph<int, long> {
+		auto engine = std::mt19937(seed);
+		auto node = std::uniform_int_distribution<int>(0, nodes - 1);
+		auto base = std::uniform_int_distribution<long>(0, 10);
+		auto potential = std::uniform_int_distribution<long>(0, 40);
+		auto potentials = std::vector<long>(static_cast<std::size_t>(nodes));
+		for (auto& p : potentials) {
+			p = potential(engine);
+		}
+		auto g = gdwg::graph<int, long>{};
+		for (auto i = 0; i < nodes; ++i) {
+			g.insert_node(i);
+		}
+		for (auto i = 0; i < edges; ++i) {
+			auto const src = node(engine);
+			auto const dst = node(engine);
+			g.insert_edge(src,
+			              dst,
+			              base(engine) + potentials[static_cast<std::size_t>(src)]
+			                  - potentials[static_cast<std::size_t>(dst)]);
+		}
+		return g;
+	}
+
+	// Checks that cycle is a cycle of g whose cheapest edges sum below zero.
+	auto check_negative_cycle(gdwg::graph<int, long> const& g, std::vector<std::uint32_t> const& cycle) -> void {
+		REQUIRE(!cycle.empty());
+		auto total = 0L;
+		for (auto i = std::size_t{0}; i < cycle.size(); ++i) {
+			auto const next = cycle[(i + 1) % cycle.size()];
+			auto cheapest = std::optional<long>{};
+			for (auto const& record : g.out_edges(cycle[i])) {
+				if (record.dst == next) {
+					cheapest = std::min(cheapest.value_or(*record.weight), *record.weight);
+				}
+			}
+			REQUIRE(cheapest);
+			total += *cheapest;
+		}
+		CHECK(total < 0);
+	}
+} // namespace
+
+TEST_CASE("Bellman-Ford - Matches Reference With Negative Weights") {
+	auto const edges = GENERATE(200, 800, 3000);
+	auto const g = potential_graph(static_cast<unsigned>(edges), 300, edges);
+	for (auto source : {0, 7, 150}) {
+		auto const result = gdwg::bellman_ford(g, source);
+		REQUIRE(!result.has_negative_cycle());
+		CHECK(result.tree.distances == reference_distances(g, source, 1L));
+		for (auto v = std::uint32_t{0}; v < g.node_count(); ++v) {
+			auto const path = result.tree.path_to(v);
+			if (!path.empty()) {
+				CHECK(path.front() == *g.id_of(source));
+				CHECK(path.back() == v);
+			}
+		}
+	}
+	CHECK(gdwg::find_negative_cycle(g).empty());
+}
+
+TEST_CASE("Bellman-Ford - Parallel Edges Use The Cheapest") {
+	auto g = gdwg::graph<std::string, int>{"usd", "eur", "gbp"};
+	g.insert_edge("usd", "eur", 5);
+	g.insert_edge("usd", "eur", -2);
+	g.insert_edge("usd", "eur");
+	g.insert_edge("eur", "gbp", 3);
+	g.insert_edge("eur", "gbp");
+	auto const result = gdwg::bellman_ford(g, "usd", 4);
+	REQUIRE(!result.has_negative_cycle());
+	CHECK(result.tree.distances[*g.id_of("eur")] == -2);
+	CHECK(result.tree.distances[*g.id_of("gbp")] == 1);
+	CHECK(result.tree.settled == 3);
+}
+
+TEST_CASE("Bellman-Ford - Negative Cycle Witness") {
+	auto g = potential_graph(5, 200, 800);
+	g.insert_edge(10, 11, -100);
+	g.insert_edge(11, 12, 20);
+	g.insert_edge(12, 10, 20);
+
+	auto const result = gdwg::bellman_ford(g, 10);
+	REQUIRE(result.has_negative_cycle());
+	check_negative_cycle(g, result.negative_cycle);
+	check_negative_cycle(g, gdwg::find_negative_cycle(g));
+
+	// A cycle no source reaches is still found when searching from every node.
+	auto island = gdwg::graph<int, long>{1, 2, 3};
+	island.insert_edge(2, 3, -1);
+	island.insert_edge(3, 2, 0);
+	island.insert_edge(3, 2, 4);
+	CHECK(!gdwg::bellman_ford(island, 1).has_negative_cycle());
+	auto const cycle = gdwg::find_negative_cycle(island);
+	check_negative_cycle(island, cycle);
+	CHECK(cycle.size() == 2);
+
+	auto loop = gdwg::graph<int, long>{1};
+	loop.insert_edge(1, 1, -1);
+	CHECK(gdwg::bellman_ford(loop, 1).negative_cycle == std::vector<std::uint32_t>{0});
+}
+
+TEST_CASE("Bellman-Ford - Long Negative Cycle") {
+	// A ring that is only just negative, so path lengths pass n long before the cycle shows.
+	constexpr auto length = 20000;
+	auto g = gdwg::graph<int, long>{};
+	for (auto i = 0; i < length; ++i) {
+		g.insert_node(i);
+	}
+	for (auto i = 0; i + 1 < length; ++i) {
+		g.insert_edge(i, i + 1, 1);
+	}
+	g.insert_edge(length - 1, 0, -length);
+	auto const result = gdwg::bellman_ford(g, 0);
+	REQUIRE(result.has_negative_cycle());
+	check_negative_cycle(g, result.negative_cycle);
+	CHECK(result.negative_cycle.size() == std::size_t{length});
+}
+
+TEST_CASE("Bellman-Ford - Errors") {
+	auto const g = gdwg::graph<int, int>{1, 2};
+	CHECK_THROWS_MATCHES(
+	    gdwg::bellman_ford(g, 3),
+	    std::runtime_error,
+	    Catch::Matchers::Message("Cannot call gdwg::bellman_ford if source doesn't exist in the graph"));
+}
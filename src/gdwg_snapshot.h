@@ -0,0 +1,499 @@
+#ifndef GDWG_SNAPSHOT_H
+#define GDWG_SNAPSHOT_H
+
+#include "gdwg_csr_graph.h"
+#include "gdwg_graph.h"
+
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <limits>
+#include <optional>
+#include <ranges>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace gdwg {
+	// A binary snapshot is a fixed header followed by five sections, each starting on a 64 byte
+	// boundary: the sorted node table, the CSR row offsets, the destination ids, one presence byte
+	// per edge and one weight slot per edge. Absent weights are written as zero bytes. Everything is
+	// stored in native byte order and layout, so a snapshot is only readable on a machine and build
+	// with the same byte order and the same sizes for N and E. For the same reason E must be
+	// trivially copyable, and so must N unless it is std::string. String nodes are written as a
+	// string table instead: node_count + 1 byte offsets followed by the concatenated characters,
+	// recorded with a node size of 0.
+	namespace detail {
+		inline constexpr auto snapshot_magic = std::array<char, 8>{'G', 'D', 'W', 'G', 'S', 'N', 'A', 'P'};
+		inline constexpr auto snapshot_version = std::uint32_t{1};
+		inline constexpr auto snapshot_byte_order = std::uint32_t{0x01020304};
+		inline constexpr auto snapshot_alignment = std::uint64_t{64};
+
+		enum snapshot_section : std::size_t {
+			nodes_section,
+			offsets_section,
+			destinations_section,
+			flags_section,
+			weights_section,
+			section_count
+		};
+
+		struct snapshot_header {
+			std::array<char, 8> magic;
+			std::uint32_t version;
+			std::uint32_t byte_order;
+			std::uint32_t node_size;
+			std::uint32_t weight_size;
+			std::uint64_t node_count;
+			std::uint64_t edge_count;
+			std::array<std::uint64_t, section_count> section_offsets;
+			std::array<std::uint64_t, section_count> section_sizes;
+			std::array<std::uint64_t, section_count> section_checksums;
+			// Covers every field above it.
+			std::uint64_t header_checksum;
+		};
+		static_assert(std::is_trivially_copyable_v<snapshot_header>);
+
+		// FNV-1a over 64 bit words, with the tail zero padded. It only has to catch truncated and
+		// corrupted files, and a word at a time keeps verification close to memory bandwidth.
+		inline auto snapshot_checksum(std::span<std::byte const> bytes) noexcept -> std::uint64_t {
+			auto hash = std::uint64_t{0xcbf29ce484222325};
+			auto constexpr prime = std::uint64_t{0x100000001b3};
+			auto i = std::size_t{0};
+			for (; i + sizeof(std::uint64_t) <= bytes.size(); i += sizeof(std::uint64_t)) {
+				auto word = std::uint64_t{0};
+				std::memcpy(&word, bytes.data() + i, sizeof(word));
+				hash = (hash ^ word) * prime;
+			}
+			if (i < bytes.size()) {
+				auto word = std::uint64_t{0};
+				std::memcpy(&word, bytes.data() + i, bytes.size() - i);
+				hash = (hash ^ word) * prime;
+			}
+			return hash ^ bytes.size();
+		}
+
+		inline auto header_checksum(snapshot_header const& header) noexcept -> std::uint64_t {
+			auto const* first = reinterpret_cast<std::byte const*>(&header);
+			return snapshot_checksum({first, offsetof(snapshot_header, header_checksum)});
+		}
+
+		inline auto align_snapshot_offset(std::uint64_t offset) noexcept -> std::uint64_t {
+			return (offset + snapshot_alignment - 1) / snapshot_alignment * snapshot_alignment;
+		}
+
+		// The node size a header records: the size of N when its values are stored as raw bytes,
+		// and 0 when they are stored as a string table.
+		template<typename N>
+		inline constexpr auto snapshot_node_size =
+		    std::is_trivially_copyable_v<N> ? static_cast<std::uint32_t>(sizeof(N)) : std::uint32_t{0};
+
+		// Lays values out as values.size() + 1 byte offsets followed by the concatenated
+		// characters, so any value can be found in O(1) without reading the ones before it.
+		inline auto make_string_table(std::span<std::string const> values) -> std::vector<std::byte> {
+			auto const prefix = (values.size() + 1) * sizeof(std::uint64_t);
+			auto characters = std::size_t{0};
+			for (auto const& value : values) {
+				characters += value.size();
+			}
+			auto table = std::vector<std::byte>(prefix + characters);
+			auto offset = std::uint64_t{0};
+			for (auto i = std::size_t{0}; i < values.size(); ++i) {
+				std::memcpy(table.data() + i * sizeof(offset), &offset, sizeof(offset));
+				std::memcpy(table.data() + prefix + offset, values[i].data(), values[i].size());
+				offset += values[i].size();
+			}
+			std::memcpy(table.data() + values.size() * sizeof(offset), &offset, sizeof(offset));
+			return table;
+		}
+	} // namespace detail
+
+	template<typename N, typename E>
+	concept snapshot_storable = (std::is_trivially_copyable_v<N> or std::same_as<N, std::string>)
+	                            and std::is_trivially_copyable_v<E>;
+
+	// Writes csr to os as a binary snapshot. Throws std::runtime_error if the stream fails.
+	template<typename N, typename E>
+	requires snapshot_storable<N, E>
+	auto save_snapshot(csr_graph<N, E> const& csr, std::ostream& os) -> void {
+		using namespace detail;
+		auto const nodes = csr.nodes();
+		auto const weights = csr.weights();
+		auto offsets = std::vector<std::uint64_t>(csr.offsets().begin(), csr.offsets().end());
+		auto flags = std::vector<std::uint8_t>(weights.size());
+		auto values = std::vector<std::byte>(weights.size() * sizeof(E));
+		for (auto i = std::size_t{0}; i < weights.size(); ++i) {
+			if (weights[i]) {
+				flags[i] = 1;
+				std::memcpy(values.data() + i * sizeof(E), &*weights[i], sizeof(E));
+			}
+		}
+
+		auto string_table = std::vector<std::byte>{};
+		auto node_bytes = std::span<std::byte const>{};
+		if constexpr (std::is_trivially_copyable_v<N>) {
+			node_bytes = std::as_bytes(std::span<N const>(nodes));
+		}
+		else {
+			string_table = make_string_table(nodes);
+			node_bytes = string_table;
+		}
+
+		auto const sections = std::array<std::span<std::byte const>, section_count>{
+		    node_bytes,
+		    std::as_bytes(std::span<std::uint64_t const>(offsets)),
+		    std::as_bytes(csr.destinations()),
+		    std::as_bytes(std::span<std::uint8_t const>(flags)),
+		    std::span<std::byte const>(values),
+		};
+
+		auto header = snapshot_header{};
+		header.magic = snapshot_magic;
+		header.version = snapshot_version;
+		header.byte_order = snapshot_byte_order;
+		header.node_size = snapshot_node_size<N>;
+		header.weight_size = static_cast<std::uint32_t>(sizeof(E));
+		header.node_count = csr.node_count();
+		header.edge_count = csr.edge_count();
+		auto offset = align_snapshot_offset(sizeof(snapshot_header));
+		for (auto i = std::size_t{0}; i < section_count; ++i) {
+			header.section_offsets[i] = offset;
+			header.section_sizes[i] = sections[i].size();
+			header.section_checksums[i] = snapshot_checksum(sections[i]);
+			offset = align_snapshot_offset(offset + sections[i].size());
+		}
+		header.header_checksum = header_checksum(header);
+
+		auto const padding = std::array<char, snapshot_alignment>{};
+		auto written = std::uint64_t{sizeof(snapshot_header)};
+		os.write(reinterpret_cast<char const*>(&header), sizeof(header));
+		for (auto i = std::size_t{0}; i < section_count; ++i) {
+			os.write(padding.data(), static_cast<std::streamsize>(header.section_offsets[i] - written));
+			os.write(reinterpret_cast<char const*>(sections[i].data()),
+			         static_cast<std::streamsize>(sections[i].size()));
+			written = header.section_offsets[i] + sections[i].size();
+		}
+		if (!os) {
+			throw std::runtime_error("Cannot call gdwg::save_snapshot when the output stream fails");
+		}
+	}
+
+	template<typename N, typename E>
+	requires snapshot_storable<N, E>
+	auto save_snapshot(graph<N, E> const& g, std::ostream& os) -> void {
+		save_snapshot(csr_graph<N, E>(g), os);
+	}
+
+	template<typename N, typename E>
+	requires snapshot_storable<N, E>
+	auto save_snapshot(graph<N, E> const& g, std::string const& path) -> void {
+		auto file = std::ofstream(path, std::ios::binary | std::ios::trunc);
+		if (!file) {
+			throw std::runtime_error("Cannot call gdwg::save_snapshot when the file cannot be opened: " + path);
+		}
+		save_snapshot(g, file);
+	}
+
+	// A read-only view of a snapshot file mapped into memory. Opening it checks the header and the
+	// section bounds in O(1), but never copies or parses the node and edge arrays; they are served
+	// straight from the mapping and paged in on first touch. Verification, on by default, also
+	// checks the section checksums and that every row offset, destination and string offset is in
+	// range. Without it node(), out_destinations() and the other accessors trust the file, though
+	// to_graph() still checks everything it reads.
+	template<typename N, typename E>
+	requires snapshot_storable<N, E>
+	class snapshot_view {
+	 public:
+		using node_id = std::uint32_t;
+		// Node values are served from the mapping: by reference when N is stored as raw bytes, and
+		// as a view into the string table when it is not.
+		using node_reference = std::conditional_t<std::is_trivially_copyable_v<N>, N const&, std::string_view>;
+
+		// Constructors and Destructors
+		explicit snapshot_view(std::string const& path, bool verify = true) {
+			auto const fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+			if (fd == -1) {
+				throw std::runtime_error("Cannot open gdwg::snapshot_view when the file cannot be opened: " + path);
+			}
+			struct ::stat status = {};
+			if (::fstat(fd, &status) == -1
+			    or static_cast<std::size_t>(status.st_size) < sizeof(detail::snapshot_header))
+			{
+				::close(fd);
+				throw std::runtime_error("Cannot open gdwg::snapshot_view when the file is not a snapshot: " + path);
+			}
+			size_ = static_cast<std::size_t>(status.st_size);
+			auto* data = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+			::close(fd);
+			if (data == MAP_FAILED) {
+				throw std::runtime_error("Cannot open gdwg::snapshot_view when the file cannot be mapped: " + path);
+			}
+			data_ = static_cast<std::byte const*>(data);
+			try {
+				validate(verify);
+			} catch (...) {
+				unmap();
+				throw;
+			}
+		}
+
+		~snapshot_view() {
+			unmap();
+		}
+
+		snapshot_view(snapshot_view&& other) noexcept
+		: data_{std::exchange(other.data_, nullptr)}
+		, size_{std::exchange(other.size_, 0)}
+		, header_{other.header_} {}
+
+		auto operator=(snapshot_view&& other) noexcept -> snapshot_view& {
+			if (this != &other) {
+				unmap();
+				data_ = std::exchange(other.data_, nullptr);
+				size_ = std::exchange(other.size_, 0);
+				header_ = other.header_;
+			}
+			return *this;
+		}
+
+		snapshot_view(snapshot_view const& other) = delete;
+		auto operator=(snapshot_view const& other) -> snapshot_view& = delete;
+
+		// Conversion
+		[[nodiscard]] auto to_graph() const -> graph<N, E> {
+			auto const table = node_table();
+			auto g = graph<N, E>{};
+			g.insert_nodes(table);
+			auto batch = std::vector<std::tuple<N, N, std::optional<E>>>{};
+			batch.reserve(edge_count());
+			auto const row = offsets();
+			auto const dst = destinations();
+			// Every value is read anyway, so an unverified file costs nothing extra to check here.
+			for (auto src = node_id{0}; src < node_count(); ++src) {
+				if (row[src] > row[src + 1]) {
+					throw std::runtime_error("Cannot call gdwg::snapshot_view<N, E>::to_graph when the row offsets "
+					                         "are malformed");
+				}
+				for (auto i = row[src]; i < row[src + 1]; ++i) {
+					if (dst[i] >= node_count()) {
+						throw std::runtime_error("Cannot call gdwg::snapshot_view<N, E>::to_graph when an edge refers "
+						                         "to a node outside the node table");
+					}
+					batch.emplace_back(table[src], table[dst[i]], weight(static_cast<std::size_t>(i)));
+				}
+			}
+			// Rows are already in graph order, so the batch insert skips its sort.
+			g.insert_edges(batch);
+			return g;
+		}
+
+		[[nodiscard]] auto to_csr() const -> csr_graph<N, E> {
+			return csr_graph<N, E>(to_graph());
+		}
+
+		// Dense Access
+		[[nodiscard]] auto node_count() const noexcept -> std::size_t {
+			return static_cast<std::size_t>(header_.node_count);
+		}
+
+		[[nodiscard]] auto edge_count() const noexcept -> std::size_t {
+			return static_cast<std::size_t>(header_.edge_count);
+		}
+
+		[[nodiscard]] auto nodes() const noexcept -> std::span<N const>
+		requires std::is_trivially_copyable_v<N>
+		{
+			return section<N>(detail::nodes_section, node_count());
+		}
+
+		[[nodiscard]] auto offsets() const noexcept -> std::span<std::uint64_t const> {
+			return section<std::uint64_t>(detail::offsets_section, node_count() + 1);
+		}
+
+		[[nodiscard]] auto destinations() const noexcept -> std::span<node_id const> {
+			return section<node_id>(detail::destinations_section, edge_count());
+		}
+
+		[[nodiscard]] auto id_of(N const& value) const -> std::optional<node_id> {
+			auto const ids = std::views::iota(node_id{0}, static_cast<node_id>(node_count()));
+			auto it = std::ranges::lower_bound(ids, value, std::less<>{}, [this](node_id id) -> node_reference {
+				return node(id);
+			});
+			if (it == ids.end() or node(*it) != value) {
+				return std::nullopt;
+			}
+			return *it;
+		}
+
+		[[nodiscard]] auto node(node_id id) const -> node_reference {
+			if constexpr (std::is_trivially_copyable_v<N>) {
+				return nodes()[id];
+			}
+			else {
+				auto const ends = string_offsets();
+				auto const first = header_.section_offsets[detail::nodes_section] + ends.size_bytes();
+				auto const* characters = reinterpret_cast<char const*>(data_ + first);
+				return {characters + ends[id], static_cast<std::size_t>(ends[id + 1] - ends[id])};
+			}
+		}
+
+		[[nodiscard]] auto out_destinations(node_id id) const -> std::span<node_id const> {
+			auto const row = offsets();
+			auto const first = static_cast<std::size_t>(row[id]);
+			return destinations().subspan(first, static_cast<std::size_t>(row[id + 1]) - first);
+		}
+
+		// The weight of the edge at index in destinations().
+		[[nodiscard]] auto weight(std::size_t index) const -> std::optional<E> {
+			if (section<std::uint8_t>(detail::flags_section, edge_count())[index] == 0) {
+				return std::nullopt;
+			}
+			return section<E>(detail::weights_section, edge_count())[index];
+		}
+
+	 private:
+		// The byte offsets of each value in the string table, relative to its first character.
+		auto string_offsets() const noexcept -> std::span<std::uint64_t const> {
+			return section<std::uint64_t>(detail::nodes_section, node_count() + 1);
+		}
+
+		// Every node value in id order, copied out only when it is not stored as raw bytes.
+		auto node_table() const {
+			if constexpr (std::is_trivially_copyable_v<N>) {
+				return nodes();
+			}
+			else {
+				// Checked here rather than in node(), which stays a plain lookup on verified files.
+				auto const ends = string_offsets();
+				auto table = std::vector<N>{};
+				table.reserve(node_count());
+				for (auto id = node_id{0}; id < node_count(); ++id) {
+					if (ends[id] > ends[id + 1] or ends[id + 1] > ends.back()) {
+						throw std::runtime_error("Cannot call gdwg::snapshot_view<N, E>::to_graph when the string "
+						                         "table is malformed");
+					}
+					table.emplace_back(node(id));
+				}
+				return table;
+			}
+		}
+
+		template<typename T>
+		auto section(detail::snapshot_section which, std::size_t count) const noexcept -> std::span<T const> {
+			return {reinterpret_cast<T const*>(data_ + header_.section_offsets[which]), count};
+		}
+
+		auto validate(bool verify) -> void {
+			using namespace detail;
+			std::memcpy(&header_, data_, sizeof(header_));
+			auto fail = [](char const* reason) {
+				throw std::runtime_error(std::string("Cannot open gdwg::snapshot_view when ") + reason);
+			};
+			if (header_.magic != snapshot_magic) {
+				fail("the file is not a snapshot");
+			}
+			if (header_.header_checksum != header_checksum(header_)) {
+				fail("the header is corrupt");
+			}
+			if (header_.version != snapshot_version) {
+				fail("the snapshot version is unsupported");
+			}
+			if (header_.byte_order != snapshot_byte_order or header_.node_size != snapshot_node_size<N>
+			    or header_.weight_size != sizeof(E))
+			{
+				fail("the snapshot was written with a different byte order or node and weight types");
+			}
+			// Bound the counts by the file size first, so the sizes below cannot overflow. A string
+			// table holds at least one offset per node.
+			constexpr auto stored_node_size = std::is_trivially_copyable_v<N> ? sizeof(N) : sizeof(std::uint64_t);
+			if (header_.node_count > std::numeric_limits<node_id>::max()
+			    or header_.node_count > size_ / stored_node_size
+			    or header_.node_count >= size_ / sizeof(std::uint64_t) or header_.edge_count > size_ / sizeof(node_id)
+			    or header_.edge_count > size_ / sizeof(E))
+			{
+				fail("the file is truncated or its sections are malformed");
+			}
+			// A string table's characters follow its offsets, so only its minimum size is known here.
+			auto const expected_sizes = std::array<std::uint64_t, section_count>{
+			    (header_.node_count + (std::is_trivially_copyable_v<N> ? 0 : 1)) * stored_node_size,
+			    (header_.node_count + 1) * sizeof(std::uint64_t),
+			    header_.edge_count * sizeof(node_id),
+			    header_.edge_count * sizeof(std::uint8_t),
+			    header_.edge_count * sizeof(E),
+			};
+			for (auto i = std::size_t{0}; i < section_count; ++i) {
+				auto const offset = header_.section_offsets[i];
+				auto const size = header_.section_sizes[i];
+				auto const exact = i != nodes_section or std::is_trivially_copyable_v<N>;
+				if ((exact ? size != expected_sizes[i] : size < expected_sizes[i]) or offset % snapshot_alignment != 0
+				    or offset > size_ or size > size_ - offset)
+				{
+					fail("the file is truncated or its sections are malformed");
+				}
+				auto const bytes = std::span<std::byte const>(data_ + offset, static_cast<std::size_t>(size));
+				if (verify and snapshot_checksum(bytes) != header_.section_checksums[i]) {
+					fail("a section checksum does not match");
+				}
+			}
+			// The first and last offsets are checked in O(1) on every open; the full scan below
+			// touches every page of the mapping, so it runs only when verifying.
+			auto const row = offsets();
+			if (row.front() != 0 or row.back() != header_.edge_count) {
+				fail("the row offsets are malformed");
+			}
+			if constexpr (!std::is_trivially_copyable_v<N>) {
+				auto const ends = string_offsets();
+				if (ends.front() != 0 or ends.back() != header_.section_sizes[nodes_section] - ends.size_bytes()) {
+					fail("the string table is malformed");
+				}
+				if (verify and !std::is_sorted(ends.begin(), ends.end())) {
+					fail("the string table is malformed");
+				}
+			}
+			if (!verify) {
+				return;
+			}
+			if (!std::is_sorted(row.begin(), row.end())) {
+				fail("the row offsets are malformed");
+			}
+			auto const dst = destinations();
+			if (std::any_of(dst.begin(), dst.end(), [this](node_id id) { return id >= header_.node_count; })) {
+				fail("an edge refers to a node outside the node table");
+			}
+		}
+
+		auto unmap() noexcept -> void {
+			if (data_ != nullptr) {
+				::munmap(const_cast<std::byte*>(data_), size_);
+				data_ = nullptr;
+			}
+		}
+
+		std::byte const* data_ = nullptr;
+		std::size_t size_ = 0;
+		detail::snapshot_header header_ = {};
+	};
+
+	template<typename N, typename E>
+	requires snapshot_storable<N, E>
+	auto load_snapshot(std::string const& path) -> graph<N, E> {
+		return snapshot_view<N, E>(path).to_graph();
+	}
+} // namespace gdwg
+
+#endif // GDWG_SNAPSHOT_H
@@ -0,0 +1,305 @@
+#include "gdwg_snapshot.h"
+
+#include <catch2/catch.hpp>
+
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+	auto make_graph() -> gdwg::graph<int, double> {
+		auto g = gdwg::graph<int, double>{1, 2, 3, 4, 5, 64};
+		CHECK(g.insert_edge(4, 1, -4.5));
+		CHECK(g.insert_edge(3, 2, 2));
+		CHECK(g.insert_edge(2, 4));
+		CHECK(g.insert_edge(2, 4, 2));
+		CHECK(g.insert_edge(2, 1, 1));
+		CHECK(g.insert_edge(4, 1));
+		CHECK(g.insert_edge(1, 5, -1));
+		CHECK(g.insert_edge(4, 5, 3));
+		CHECK(g.insert_edge(5, 5));
+		return g;
+	}
+
+	// A uniquely named file in the temporary directory, removed when it goes out of scope.
+	struct temp_file {
+		explicit temp_file(std::string const& name)
+		: path{(std::filesystem::temp_directory_path() / ("gdwg_snapshot_test_" + name)).string()} {}
+		~temp_file() {
+			std::filesystem::remove(path);
+		}
+		temp_file(temp_file const&) = delete;
+		auto operator=(temp_file const&) -> temp_file& = delete;
+
+		std::string path;
+	};
+
+	auto flip_byte(std::string const& path, std::streamoff offset) -> void {
+		auto file = std::fstream(path, std::ios::binary | std::ios::in | std::ios::out);
+		file.seekg(offset);
+		auto byte = static_cast<char>(file.get());
+		file.seekp(offset);
+		file.put(static_cast<char>(~byte));
+	}
+
+	// Applies edit to the header of the snapshot at path and reseals it with a valid checksum.
+	template<typename F>
+	auto edit_header(std::string const& path, F edit) -> gdwg::detail::snapshot_header {
+		auto file = std::fstream(path, std::ios::binary | std::ios::in | std::ios::out);
+		auto header = gdwg::detail::snapshot_header{};
+		file.read(reinterpret_cast<char*>(&header), sizeof(header));
+		edit(header);
+		header.header_checksum = gdwg::detail::header_checksum(header);
+		file.seekp(0);
+		file.write(reinterpret_cast<char const*>(&header), sizeof(header));
+		return header;
+	}
+
+	// Recomputes every section checksum of the snapshot at path, so that only structural checks
+	// can catch an edit.
+	auto reseal(std::string const& path) -> void {
+		auto file = std::ifstream(path, std::ios::binary);
+		auto bytes = std::vector<char>(std::istreambuf_iterator<char>(file), {});
+		edit_header(path, [&bytes](gdwg::detail::snapshot_header& header) {
+			for (auto i = std::size_t{0}; i < gdwg::detail::section_count; ++i) {
+				auto const first = reinterpret_cast<std::byte const*>(bytes.data() + header.section_offsets[i]);
+				header.section_checksums[i] =
+				    gdwg::detail::snapshot_checksum({first, static_cast<std::size_t>(header.section_sizes[i])});
+			}
+		});
+	}
+} // namespace
+
+TEST_CASE("Snapshot - Round Trip") {
+	auto const g = make_graph();
+	auto const file = temp_file("round_trip");
+	gdwg::save_snapshot(g, file.path);
+
+	auto const loaded = gdwg::load_snapshot<int, double>(file.path);
+	CHECK(loaded == g);
+	std::ostringstream expected;
+	std::ostringstream out;
+	expected << g;
+	out << loaded;
+	CHECK(out.str() == expected.str());
+}
+
+TEST_CASE("Snapshot - Empty Graphs") {
+	auto const file = temp_file("empty");
+	SECTION("No nodes") {
+		gdwg::save_snapshot(gdwg::graph<int, int>{}, file.path);
+		auto const view = gdwg::snapshot_view<int, int>(file.path);
+		CHECK(view.node_count() == 0);
+		CHECK(view.edge_count() == 0);
+		CHECK(view.to_graph() == gdwg::graph<int, int>{});
+	}
+
+	SECTION("Nodes without edges") {
+		auto const g = gdwg::graph<int, int>{3, 1, 2};
+		gdwg::save_snapshot(g, file.path);
+		CHECK(gdwg::load_snapshot<int, int>(file.path) == g);
+	}
+}
+
+TEST_CASE("Snapshot - Mapped View") {
+	auto const g = make_graph();
+	auto const file = temp_file("view");
+	gdwg::save_snapshot(g, file.path);
+
+	auto view = gdwg::snapshot_view<int, double>(file.path);
+	auto const csr = gdwg::csr_graph<int, double>(g);
+	CHECK(view.node_count() == csr.node_count());
+	CHECK(view.edge_count() == csr.edge_count());
+	CHECK(std::vector<int>(view.nodes().begin(), view.nodes().end()) == g.nodes());
+	CHECK(std::equal(view.offsets().begin(), view.offsets().end(), csr.offsets().begin(), csr.offsets().end()));
+	CHECK(std::ranges::equal(view.destinations(), csr.destinations()));
+	for (auto i = std::size_t{0}; i < view.edge_count(); ++i) {
+		CHECK(view.weight(i) == csr.weights()[i]);
+	}
+
+	auto const four = view.id_of(4);
+	REQUIRE(four.has_value());
+	CHECK(view.node(*four) == 4);
+	CHECK(view.out_destinations(*four).size() == 3);
+	CHECK(view.id_of(7) == std::nullopt);
+
+	// Moving transfers the mapping.
+	auto moved = std::move(view);
+	CHECK(moved.to_csr() == csr);
+}
+
+TEST_CASE("Snapshot - String Nodes") {
+	auto g = gdwg::graph<std::string, int>{"how", "are", "you?", "", "hello world"};
+	CHECK(g.insert_edge("how", "you?", 24));
+	CHECK(g.insert_edge("how", "hello world", 1));
+	CHECK(g.insert_edge("are", ""));
+	CHECK(g.insert_edge("", "how", -3));
+	CHECK(g.insert_edge("you?", "you?"));
+	auto const file = temp_file("strings");
+	gdwg::save_snapshot(g, file.path);
+
+	auto const view = gdwg::snapshot_view<std::string, int>(file.path);
+	CHECK(view.node_count() == 5);
+	CHECK(view.edge_count() == 5);
+	for (auto const& value : g.nodes()) {
+		auto const id = view.id_of(value);
+		REQUIRE(id.has_value());
+		CHECK(view.node(*id) == value);
+	}
+	CHECK(view.id_of("who") == std::nullopt);
+	CHECK(view.out_destinations(*view.id_of("how")).size() == 2);
+	CHECK(view.to_graph() == g);
+	CHECK(gdwg::load_snapshot<std::string, int>(file.path) == g);
+
+	CHECK_THROWS_MATCHES((gdwg::snapshot_view<int, int>(file.path)),
+	                     std::runtime_error,
+	                     Catch::Matchers::Message("Cannot open gdwg::snapshot_view when the snapshot was written "
+	                                              "with a different byte order or node and weight types"));
+
+	SECTION("Out of range string offsets") {
+		auto const header = edit_header(file.path, [](gdwg::detail::snapshot_header&) {});
+		auto const ends = static_cast<std::streamoff>(header.section_offsets[gdwg::detail::nodes_section]);
+		auto const patch = [&file, ends](std::streamoff index, std::uint64_t value) {
+			auto out = std::fstream(file.path, std::ios::binary | std::ios::in | std::ios::out);
+			out.seekp(ends + index * static_cast<std::streamoff>(sizeof(value)));
+			out.write(reinterpret_cast<char const*>(&value), sizeof(value));
+		};
+		// Past the end of the characters, then running backwards.
+		for (auto const value : {std::uint64_t{1} << 40, std::uint64_t{15}}) {
+			patch(2, value);
+			// Opening without verification only checks the first and last offsets.
+			auto const view = gdwg::snapshot_view<std::string, int>(file.path, false);
+			CHECK_THROWS_MATCHES(view.to_graph(),
+			                     std::runtime_error,
+			                     Catch::Matchers::Message("Cannot call gdwg::snapshot_view<N, E>::to_graph when the "
+			                                              "string table is malformed"));
+			reseal(file.path);
+			CHECK_THROWS_MATCHES((gdwg::snapshot_view<std::string, int>(file.path)),
+			                     std::runtime_error,
+			                     Catch::Matchers::Message("Cannot open gdwg::snapshot_view when the string table is "
+			                                              "malformed"));
+		}
+	}
+
+	SECTION("Corrupt string table") {
+		auto const header = edit_header(file.path, [](gdwg::detail::snapshot_header&) {});
+		// The last offset no longer matches the number of characters that follow the table.
+		flip_byte(file.path,
+		          static_cast<std::streamoff>(header.section_offsets[gdwg::detail::nodes_section] + 5 * 8));
+		CHECK_THROWS_MATCHES((gdwg::snapshot_view<std::string, int>(file.path, false)),
+		                     std::runtime_error,
+		                     Catch::Matchers::Message("Cannot open gdwg::snapshot_view when the string table is "
+		                                              "malformed"));
+	}
+}
+
+TEST_CASE("Snapshot - Stream Round Trip Of Random Graph") {
+	auto engine = std::mt19937(7);
+	auto g = gdwg::graph<std::uint64_t, std::int16_t>{};
+	for (auto i = std::uint64_t{0}; i < 300; ++i) {
+		g.insert_node(i * 977);
+	}
+	auto node = std::uniform_int_distribution<std::uint64_t>(0, 299);
+	auto weight = std::uniform_int_distribution<std::int16_t>(-50, 50);
+	for (auto i = 0; i < 3000; ++i) {
+		auto const src = node(engine) * 977;
+		auto const dst = node(engine) * 977;
+		if (i % 5 == 0) {
+			g.insert_edge(src, dst);
+		}
+		else {
+			g.insert_edge(src, dst, weight(engine));
+		}
+	}
+
+	std::ostringstream out(std::ios::binary);
+	gdwg::save_snapshot(g, out);
+	auto const file = temp_file("random");
+	std::ofstream(file.path, std::ios::binary) << out.str();
+	CHECK(gdwg::load_snapshot<std::uint64_t, std::int16_t>(file.path) == g);
+}
+
+TEST_CASE("Snapshot - Rejects Invalid Files") {
+	auto const file = temp_file("invalid");
+
+	SECTION("Missing file") {
+		CHECK_THROWS_AS((gdwg::snapshot_view<int, int>(file.path)), std::runtime_error);
+	}
+
+	SECTION("Not a snapshot") {
+		std::ofstream(file.path) << "1 2 3\n";
+		CHECK_THROWS_AS((gdwg::snapshot_view<int, int>(file.path)), std::runtime_error);
+	}
+
+	SECTION("Different weight type") {
+		gdwg::save_snapshot(make_graph(), file.path);
+		CHECK_THROWS_MATCHES((gdwg::snapshot_view<int, float>(file.path)),
+		                     std::runtime_error,
+		                     Catch::Matchers::Message("Cannot open gdwg::snapshot_view when the snapshot was written "
+		                                              "with a different byte order or node and weight types"));
+	}
+
+	SECTION("Truncated") {
+		gdwg::save_snapshot(make_graph(), file.path);
+		std::filesystem::resize_file(file.path, std::filesystem::file_size(file.path) - 8);
+		CHECK_THROWS_MATCHES((gdwg::snapshot_view<int, double>(file.path)),
+		                     std::runtime_error,
+		                     Catch::Matchers::Message("Cannot open gdwg::snapshot_view when the file is truncated or "
+		                                              "its sections are malformed"));
+	}
+
+	SECTION("Corrupt header") {
+		gdwg::save_snapshot(make_graph(), file.path);
+		flip_byte(file.path, 20);
+		CHECK_THROWS_MATCHES((gdwg::snapshot_view<int, double>(file.path)),
+		                     std::runtime_error,
+		                     Catch::Matchers::Message("Cannot open gdwg::snapshot_view when the header is corrupt"));
+	}
+
+	SECTION("Corrupt section") {
+		gdwg::save_snapshot(make_graph(), file.path);
+		auto const last = static_cast<std::streamoff>(std::filesystem::file_size(file.path)) - 1;
+		flip_byte(file.path, last);
+		CHECK_THROWS_MATCHES((gdwg::snapshot_view<int, double>(file.path)),
+		                     std::runtime_error,
+		                     Catch::Matchers::Message("Cannot open gdwg::snapshot_view when a section checksum does "
+		                                              "not match"));
+		// Skipping verification still opens it.
+		CHECK(gdwg::snapshot_view<int, double>(file.path, false).edge_count() == 9);
+	}
+
+	SECTION("Counts too large for the file") {
+		gdwg::save_snapshot(make_graph(), file.path);
+		// The section sizes these counts imply wrap around to 0 and 8 bytes.
+		edit_header(file.path, [](gdwg::detail::snapshot_header& header) {
+			header.node_count = std::uint64_t{1} << 62;
+			header.section_sizes[gdwg::detail::nodes_section] = 0;
+			header.section_sizes[gdwg::detail::offsets_section] = 8;
+		});
+		CHECK_THROWS_MATCHES((gdwg::snapshot_view<int, double>(file.path, false)),
+		                     std::runtime_error,
+		                     Catch::Matchers::Message("Cannot open gdwg::snapshot_view when the file is truncated or "
+		                                              "its sections are malformed"));
+	}
+
+	SECTION("Structure is checked when verifying") {
+		gdwg::save_snapshot(make_graph(), file.path);
+		auto const header = edit_header(file.path, [](gdwg::detail::snapshot_header&) {});
+		flip_byte(file.path, static_cast<std::streamoff>(header.section_offsets[gdwg::detail::destinations_section]));
+		reseal(file.path);
+		CHECK_THROWS_MATCHES((gdwg::snapshot_view<int, double>(file.path)),
+		                     std::runtime_error,
+		                     Catch::Matchers::Message("Cannot open gdwg::snapshot_view when an edge refers to a node "
+		                                              "outside the node table"));
+		// An unverified open skips the scan, but converting still checks every destination.
+		auto const view = gdwg::snapshot_view<int, double>(file.path, false);
+		CHECK_THROWS_MATCHES(view.to_graph(),
+		                     std::runtime_error,
+		                     Catch::Matchers::Message("Cannot call gdwg::snapshot_view<N, E>::to_graph when an edge "
+		                                              "refers to a node outside the node table"));
+	}
+}
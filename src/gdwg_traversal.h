@@ -0,0 +1,401 @@
+#ifndef GDWG_TRAVERSAL_H
+#define GDWG_TRAVERSAL_H
+
+#include "gdwg_graph.h"
+#include "gdwg_parallel.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+namespace gdwg {
+	// Hop counts and parents from one source, indexed by the graph's dense node ids.
+	struct bfs_tree {
+		using node_id = std::uint32_t;
+		static constexpr auto no_node = std::numeric_limits<node_id>::max();
+		static constexpr auto unreached = std::numeric_limits<std::uint32_t>::max();
+
+		node_id source = no_node;
+		std::vector<std::uint32_t> levels;
+		std::vector<node_id> parents;
+		// How many levels were expanded in each direction.
+		std::size_t top_down_levels = 0;
+		std::size_t bottom_up_levels = 0;
+
+		[[nodiscard]] auto reached(node_id id) const -> bool {
+			return levels[id] != unreached;
+		}
+	};
+
+	enum class bfs_direction { automatic, top_down, bottom_up };
+
+	struct bfs_options {
+		bfs_direction direction = bfs_direction::automatic;
+		// Switch to bottom-up once the frontier's out-edges exceed the unexplored edges / alpha.
+		double alpha = 15.0;
+		// Switch back to top-down once the frontier holds fewer than node_count / beta nodes.
+		double beta = 18.0;
+		// Threads used when no worker_pool is supplied. Zero uses every hardware thread.
+		std::size_t threads = 0;
+	};
+
+	namespace detail {
+		inline constexpr auto bitmap_word_bits = std::size_t{64};
+
+		inline auto bitmap_words(std::size_t bits) noexcept -> std::size_t {
+			return (bits + bitmap_word_bits - 1) / bitmap_word_bits;
+		}
+
+		inline auto test_bit(std::vector<std::uint64_t> const& bitmap, std::size_t i) noexcept -> bool {
+			return ((bitmap[i / bitmap_word_bits] >> (i % bitmap_word_bits)) & 1U) != 0;
+		}
+
+		inline auto set_bit(std::vector<std::uint64_t>& bitmap, std::size_t i) noexcept -> void {
+			bitmap[i / bitmap_word_bits] |= std::uint64_t{1} << (i % bitmap_word_bits);
+		}
+
+		// Calls fn(i) for the index of every set bit in word, given the word's position in a bitmap.
+		template<typename F>
+		auto for_each_bit(std::size_t word, std::uint64_t bits, F&& fn) -> void {
+			for (; bits != 0; bits &= bits - 1) {
+				fn(word * bitmap_word_bits + static_cast<std::size_t>(std::countr_zero(bits)));
+			}
+		}
+	} // namespace detail
+
+	// Breadth-first search that follows every edge regardless of weight. Levels are expanded
+	// either top-down, with each frontier node claiming its unvisited successors, or bottom-up,
+	// with each unvisited node looking through its in-edges for a parent in the frontier. The
+	// bottom-up step reads the frontier as a bitmap and stops at the first parent it finds, so it
+	// wins on the large middle levels of low-diameter graphs. Both directions run on pool's
+	// workers. Levels are exact; when a node has several parents in the frontier, which one is
+	// recorded depends on scheduling.
+	template<typename N, typename E>
+	auto bfs(graph<N, E> const& g,
+	         std::type_identity_t<N> const& source,
+	         worker_pool& pool,
+	         bfs_options const& options = {}) -> bfs_tree {
+		using node_id = std::uint32_t;
+		auto const src =
+		    detail::id_or_throw(g, source, "Cannot call gdwg::bfs if source doesn't exist in the graph");
+		auto const n = g.node_count();
+		auto const words = detail::bitmap_words(n);
+
+		auto tree = bfs_tree{};
+		tree.source = src;
+		tree.levels.assign(n, bfs_tree::unreached);
+		auto parents = std::vector<std::atomic<node_id>>(n);
+		for (auto& parent : parents) {
+			parent.store(bfs_tree::no_node, std::memory_order_relaxed);
+		}
+
+		auto queue = std::vector<node_id>{src};
+		auto frontier_bits = std::vector<std::uint64_t>{};
+		auto next_bits = std::vector<std::uint64_t>{};
+		auto next_queues = std::vector<std::vector<node_id>>(pool.size());
+		auto worker_degrees = std::vector<std::size_t>(pool.size());
+		auto worker_counts = std::vector<std::size_t>(pool.size());
+		parents[src].store(src, std::memory_order_relaxed);
+		tree.levels[src] = 0;
+
+		auto frontier_size = std::size_t{1};
+		auto frontier_edges = g.out_edges(src).size();
+		auto unexplored_edges = g.edge_count() - frontier_edges;
+		auto bottom_up = options.direction == bfs_direction::bottom_up;
+		for (auto level = std::uint32_t{1}; frontier_size > 0; ++level) {
+			if (options.direction == bfs_direction::automatic) {
+				if (!bottom_up
+				    and static_cast<double>(frontier_edges) > static_cast<double>(unexplored_edges) / options.alpha)
+				{
+					bottom_up = true;
+				}
+				else if (bottom_up and static_cast<double>(frontier_size) < static_cast<double>(n) / options.beta) {
+					bottom_up = false;
+				}
+			}
+			std::fill(worker_degrees.begin(), worker_degrees.end(), 0);
+			std::fill(worker_counts.begin(), worker_counts.end(), 0);
+
+			if (bottom_up) {
+				++tree.bottom_up_levels;
+				if (frontier_bits.empty()) {
+					// Coming from a top-down level, whose frontier is still a queue.
+					frontier_bits.assign(words, 0);
+					for (auto u : queue) {
+						detail::set_bit(frontier_bits, u);
+					}
+				}
+				next_bits.assign(words, 0);
+				// Each block covers whole bitmap words, so every word of next_bits has one writer.
+				pool.for_each_block(words, 64, [&](std::size_t worker, std::size_t first, std::size_t last) {
+					for (auto word = first; word < last; ++word) {
+						auto bits = std::uint64_t{0};
+						auto const end = std::min(n, (word + 1) * detail::bitmap_word_bits);
+						for (auto v = word * detail::bitmap_word_bits; v < end; ++v) {
+							if (tree.levels[v] != bfs_tree::unreached) {
+								continue;
+							}
+							for (auto u : g.in_edges(static_cast<node_id>(v))) {
+								if (detail::test_bit(frontier_bits, u)) {
+									parents[v].store(u, std::memory_order_relaxed);
+									bits |= std::uint64_t{1} << (v % detail::bitmap_word_bits);
+									worker_degrees[worker] += g.out_edges(static_cast<node_id>(v)).size();
+									++worker_counts[worker];
+									break;
+								}
+							}
+						}
+						next_bits[word] = bits;
+					}
+				});
+				// Levels are written after the scan so the scan only ever sees finished levels.
+				for (auto word = std::size_t{0}; word < words; ++word) {
+					detail::for_each_bit(word, next_bits[word], [&](std::size_t v) { tree.levels[v] = level; });
+				}
+				std::swap(frontier_bits, next_bits);
+				queue.clear();
+			}
+			else {
+				++tree.top_down_levels;
+				if (queue.empty()) {
+					// Coming from a bottom-up level, whose frontier is still a bitmap.
+					for (auto word = std::size_t{0}; word < words; ++word) {
+						detail::for_each_bit(word, frontier_bits[word], [&](std::size_t v) {
+							queue.push_back(static_cast<node_id>(v));
+						});
+					}
+				}
+				pool.for_each_block(queue.size(), 256, [&](std::size_t worker, std::size_t first, std::size_t last) {
+					for (auto i = first; i < last; ++i) {
+						auto const u = queue[i];
+						for (auto const& record : g.out_edges(u)) {
+							auto expected = bfs_tree::no_node;
+							if (parents[record.dst].load(std::memory_order_relaxed) == bfs_tree::no_node
+							    and parents[record.dst].compare_exchange_strong(expected, u, std::memory_order_relaxed))
+							{
+								next_queues[worker].push_back(record.dst);
+								worker_degrees[worker] += g.out_edges(record.dst).size();
+								++worker_counts[worker];
+							}
+						}
+					}
+				});
+				queue.clear();
+				for (auto& next : next_queues) {
+					for (auto v : next) {
+						tree.levels[v] = level;
+					}
+					queue.insert(queue.end(), next.begin(), next.end());
+					next.clear();
+				}
+				frontier_bits.clear();
+			}
+
+			frontier_size = 0;
+			frontier_edges = 0;
+			for (auto worker = std::size_t{0}; worker < pool.size(); ++worker) {
+				frontier_size += worker_counts[worker];
+				frontier_edges += worker_degrees[worker];
+			}
+			unexplored_edges -= std::min(unexplored_edges, frontier_edges);
+		}
+
+		tree.parents.reserve(n);
+		for (auto const& parent : parents) {
+			tree.parents.push_back(parent.load(std::memory_order_relaxed));
+		}
+		tree.parents[src] = bfs_tree::no_node;
+		return tree;
+	}
+
+	template<typename N, typename E>
+	auto bfs(graph<N, E> const& g, std::type_identity_t<N> const& source, bfs_options const& options = {}) -> bfs_tree {
+		auto pool = worker_pool(options.threads);
+		return bfs(g, source, pool, options);
+	}
+
+	namespace detail {
+		// One bit per concurrent traversal. Fixed-size word arrays let the compiler vectorise the
+		// mask arithmetic for wider batches.
+		template<std::size_t Words>
+		using lane_mask = std::array<std::uint64_t, Words>;
+
+		template<std::size_t Words>
+		auto any_lane(lane_mask<Words> const& mask) noexcept -> bool {
+			auto bits = std::uint64_t{0};
+			for (auto word : mask) {
+				bits |= word;
+			}
+			return bits != 0;
+		}
+	} // namespace detail
+
+	// Breadth-first searches from every node in sources, run Lanes at a time (a multiple of 64).
+	// Each node keeps one bit per traversal, so one pass over an edge advances every traversal of
+	// the batch at once. Like bfs, small levels are expanded top-down from the frontier nodes,
+	// and a level whose frontier has more than edge_count / alpha out-edges is pulled bottom-up
+	// instead, with each node not yet seen by the whole batch scanning its in-edges; it switches
+	// back once the frontier holds fewer than node_count / beta nodes. Calls visit(i, node,
+	// level) on the calling thread for every node reached from sources[i], in ascending level.
+	// The expansions themselves run on pool's workers.
+	template<std::size_t Lanes = 64, typename N, typename E, typename F>
+	requires(Lanes > 0 and Lanes % 64 == 0)
+	auto multi_source_bfs(graph<N, E> const& g,
+	                      std::vector<std::type_identity_t<N>> const& sources,
+	                      worker_pool& pool,
+	                      F&& visit) -> void {
+		constexpr auto words = Lanes / detail::bitmap_word_bits;
+		constexpr auto thresholds = bfs_options{};
+		using mask = detail::lane_mask<words>;
+		auto const n = g.node_count();
+		auto ids = std::vector<std::uint32_t>{};
+		ids.reserve(sources.size());
+		for (auto const& source : sources) {
+			ids.push_back(detail::id_or_throw(g,
+			                                  source,
+			                                  "Cannot call gdwg::multi_source_bfs if a source doesn't exist in the "
+			                                  "graph"));
+		}
+
+		// Outside a level, frontier is zero except at the nodes in active, and next is all zero.
+		auto seen = std::vector<mask>(n);
+		auto frontier = std::vector<mask>(n);
+		auto next = std::vector<mask>(n);
+		auto claimed = std::vector<std::atomic<bool>>(n);
+		auto active = std::vector<std::uint32_t>{};
+		auto next_queues = std::vector<std::vector<std::uint32_t>>(pool.size());
+		for (auto first = std::size_t{0}; first < ids.size(); first += Lanes) {
+			auto const lanes = std::min(Lanes, ids.size() - first);
+			auto full = mask{};
+			for (auto lane = std::size_t{0}; lane < lanes; ++lane) {
+				full[lane / detail::bitmap_word_bits] |= std::uint64_t{1} << (lane % detail::bitmap_word_bits);
+			}
+			std::fill(seen.begin(), seen.end(), mask{});
+			active.clear();
+			for (auto lane = std::size_t{0}; lane < lanes; ++lane) {
+				auto const id = ids[first + lane];
+				if (!detail::any_lane(frontier[id])) {
+					active.push_back(id);
+				}
+				seen[id][lane / detail::bitmap_word_bits] |= std::uint64_t{1} << (lane % detail::bitmap_word_bits);
+				frontier[id] = seen[id];
+				visit(first + lane, id, std::uint32_t{0});
+			}
+
+			auto bottom_up = false;
+			for (auto level = std::uint32_t{1}; !active.empty(); ++level) {
+				auto frontier_edges = std::size_t{0};
+				for (auto u : active) {
+					frontier_edges += g.out_edges(u).size();
+				}
+				if (!bottom_up
+				    and static_cast<double>(frontier_edges)
+				            > static_cast<double>(g.edge_count()) / thresholds.alpha)
+				{
+					bottom_up = true;
+				}
+				else if (bottom_up
+				         and static_cast<double>(active.size()) < static_cast<double>(n) / thresholds.beta)
+				{
+					bottom_up = false;
+				}
+
+				if (bottom_up) {
+					pool.for_each_block(n, 256, [&](std::size_t worker, std::size_t begin, std::size_t end) {
+						for (auto v = begin; v < end; ++v) {
+							if (seen[v] == full) {
+								continue;
+							}
+							auto& found = next[v];
+							for (auto u : g.in_edges(static_cast<std::uint32_t>(v))) {
+								for (auto w = std::size_t{0}; w < words; ++w) {
+									found[w] |= frontier[u][w];
+								}
+							}
+							for (auto w = std::size_t{0}; w < words; ++w) {
+								found[w] &= ~seen[v][w];
+							}
+							if (detail::any_lane(found)) {
+								next_queues[worker].push_back(static_cast<std::uint32_t>(v));
+							}
+						}
+					});
+				}
+				else {
+					// seen is only written between levels, so each edge can mask out its own lanes.
+					pool.for_each_block(active.size(), 64, [&](std::size_t worker, std::size_t begin, std::size_t end) {
+						for (auto i = begin; i < end; ++i) {
+							auto const u = active[i];
+							for (auto const& record : g.out_edges(u)) {
+								auto const v = record.dst;
+								auto reached = false;
+								for (auto w = std::size_t{0}; w < words; ++w) {
+									if (auto const bits = frontier[u][w] & ~seen[v][w]; bits != 0) {
+										auto word = std::atomic_ref<std::uint64_t>(next[v][w]);
+										word.fetch_or(bits, std::memory_order_relaxed);
+										reached = true;
+									}
+								}
+								if (reached and !claimed[v].exchange(true, std::memory_order_relaxed)) {
+									next_queues[worker].push_back(v);
+								}
+							}
+						}
+					});
+				}
+
+				for (auto u : active) {
+					frontier[u] = mask{};
+				}
+				active.clear();
+				for (auto& queue : next_queues) {
+					active.insert(active.end(), queue.begin(), queue.end());
+					queue.clear();
+				}
+				std::sort(active.begin(), active.end());
+				std::swap(frontier, next);
+				for (auto v : active) {
+					claimed[v].store(false, std::memory_order_relaxed);
+					for (auto w = std::size_t{0}; w < words; ++w) {
+						seen[v][w] |= frontier[v][w];
+						detail::for_each_bit(w, frontier[v][w], [&](std::size_t lane) {
+							visit(first + lane, v, level);
+						});
+					}
+				}
+			}
+		}
+	}
+
+	// The hop count from each source to every node, as levels[i][node id], with
+	// bfs_tree::unreached for nodes sources[i] cannot reach.
+	template<std::size_t Lanes = 64, typename N, typename E>
+	requires(Lanes > 0 and Lanes % 64 == 0)
+	auto multi_source_bfs(graph<N, E> const& g, std::vector<std::type_identity_t<N>> const& sources, worker_pool& pool)
+	    -> std::vector<std::vector<std::uint32_t>> {
+		auto const unreached = std::vector<std::uint32_t>(g.node_count(), bfs_tree::unreached);
+		auto levels = std::vector<std::vector<std::uint32_t>>(sources.size(), unreached);
+		multi_source_bfs<Lanes>(g, sources, pool, [&levels](std::size_t i, std::uint32_t node, std::uint32_t level) {
+			levels[i][node] = level;
+		});
+		return levels;
+	}
+
+	template<std::size_t Lanes = 64, typename N, typename E>
+	requires(Lanes > 0 and Lanes % 64 == 0)
+	auto multi_source_bfs(graph<N, E> const& g,
+	                      std::vector<std::type_identity_t<N>> const& sources,
+	                      std::size_t threads = 0) -> std::vector<std::vector<std::uint32_t>> {
+		auto pool = worker_pool(threads);
+		return multi_source_bfs<Lanes>(g, sources, pool);
+	}
+} // namespace gdwg
+
+#endif // GDWG_TRAVERSAL_H
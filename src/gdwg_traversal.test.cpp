@@ -0,0 +1,197 @@
+#include "gdwg_traversal.h"
+
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+#include <deque>
+#include <optional>
+#include <random>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace {
+	auto reference_levels(gdwg::graph<int, int> const& g, int source) -> std::vector<std::uint32_t> {
+		auto levels = std::vector<std::uint32_t>(g.node_count(), gdwg::bfs_tree::unreached);
+		auto queue = std::deque<std::uint32_t>{*g.id_of(source)};
+		levels[queue.front()] = 0;
+		while (!queue.empty()) {
+			auto const u = queue.front();
+			queue.pop_front();
+			for (auto const& edge : g.out_edges(u)) {
+				if (levels[edge.dst] == gdwg::bfs_tree::unreached) {
+					levels[edge.dst] = levels[u] + 1;
+					queue.push_back(edge.dst);
+				}
+			}
+		}
+		return levels;
+	}
+
+	// A low-diameter graph with skewed degrees, plus a few isolated nodes.
+	auto social_graph(unsigned seed, int nodes, int edges) -> gdwg::graph<int, int> {
+		auto engine = std::mt19937(seed);
+		auto hub = std::uniform_int_distribution<int>(0, nodes / 50);
+		auto any = std::uniform_int_distribution<int>(0, nodes - 1);
+		auto g = gdwg::graph<int, int>{};
+		for (auto i = 0; i < nodes + 5; ++i) {
+			g.insert_node(i);
+		}
+		auto batch = std::vector<std::tuple<int, int, std::optional<int>>>{};
+		for (auto i = 0; i < edges; ++i) {
+			auto const src = i % 3 == 0 ? hub(engine) : any(engine);
+			auto const dst = i % 3 == 1 ? hub(engine) : any(engine);
+			batch.emplace_back(src, dst, i % 4 == 0 ? std::nullopt : std::optional<int>(i));
+		}
+		g.insert_edges(batch);
+		return g;
+	}
+
+	auto check_tree(gdwg::graph<int, int> const& g, gdwg::bfs_tree const& tree, int source) -> void {
+		CHECK(tree.levels == reference_levels(g, source));
+		for (auto v = std::uint32_t{0}; v < g.node_count(); ++v) {
+			auto const parent = tree.parents[v];
+			if (parent == gdwg::bfs_tree::no_node) {
+				CHECK((v == tree.source or !tree.reached(v)));
+				continue;
+			}
+			CHECK(tree.levels[parent] + 1 == tree.levels[v]);
+			CHECK(g.is_connected(g.node(parent), g.node(v)));
+		}
+	}
+} // namespace
+
+TEST_CASE("BFS - Small Graph") {
+	auto g = gdwg::graph<std::string, int>{"a", "b", "c", "d", "e"};
+	g.insert_edge("a", "b", 1);
+	g.insert_edge("a", "b");
+	g.insert_edge("b", "c", 4);
+	g.insert_edge("c", "a");
+	g.insert_edge("e", "d");
+
+	auto const direction =
+	    GENERATE(gdwg::bfs_direction::automatic, gdwg::bfs_direction::top_down, gdwg::bfs_direction::bottom_up);
+	auto options = gdwg::bfs_options{};
+	options.direction = direction;
+	auto const tree = gdwg::bfs(g, "a", options);
+	CHECK(tree.levels[*g.id_of("a")] == 0);
+	CHECK(tree.levels[*g.id_of("b")] == 1);
+	CHECK(tree.levels[*g.id_of("c")] == 2);
+	CHECK(!tree.reached(*g.id_of("d")));
+	CHECK(tree.parents[*g.id_of("c")] == *g.id_of("b"));
+	CHECK(tree.parents[*g.id_of("a")] == gdwg::bfs_tree::no_node);
+
+	CHECK_THROWS_MATCHES(gdwg::bfs(g, "z"),
+	                     std::runtime_error,
+	                     Catch::Matchers::Message("Cannot call gdwg::bfs if source doesn't exist in the graph"));
+}
+
+TEST_CASE("BFS - Directions Match Reference") {
+	auto const g = social_graph(4, 5000, 40000);
+	auto const threads = GENERATE(std::size_t{1}, std::size_t{4});
+	auto pool = gdwg::worker_pool(threads);
+	auto options = gdwg::bfs_options{};
+
+	SECTION("Automatic switches to bottom-up in the middle levels and back") {
+		auto const tree = gdwg::bfs(g, 0, pool, options);
+		check_tree(g, tree, 0);
+		CHECK(tree.top_down_levels >= 2);
+		CHECK(tree.bottom_up_levels >= 1);
+	}
+
+	SECTION("Forced top-down") {
+		options.direction = gdwg::bfs_direction::top_down;
+		auto const tree = gdwg::bfs(g, 17, pool, options);
+		check_tree(g, tree, 17);
+		CHECK(tree.bottom_up_levels == 0);
+	}
+
+	SECTION("Forced bottom-up") {
+		options.direction = gdwg::bfs_direction::bottom_up;
+		auto const tree = gdwg::bfs(g, 17, pool, options);
+		check_tree(g, tree, 17);
+		CHECK(tree.top_down_levels == 0);
+	}
+}
+
+TEST_CASE("Multi-Source BFS - Matches Single BFS") {
+	auto const g = social_graph(8, 1500, 9000);
+	auto sources = std::vector<int>{};
+	for (auto i = 0; i < 150; ++i) {
+		sources.push_back((i * 37) % 1505);
+	}
+	// Repeated sources get their own traversal.
+	sources.push_back(sources.front());
+
+	auto const threads = GENERATE(std::size_t{1}, std::size_t{3});
+	auto pool = gdwg::worker_pool(threads);
+
+	SECTION("64 lanes") {
+		auto const levels = gdwg::multi_source_bfs(g, sources, pool);
+		REQUIRE(levels.size() == sources.size());
+		for (auto i = std::size_t{0}; i < sources.size(); ++i) {
+			CHECK(levels[i] == reference_levels(g, sources[i]));
+		}
+	}
+
+	SECTION("256 lanes") {
+		auto const levels = gdwg::multi_source_bfs<256>(g, sources, pool);
+		for (auto i = std::size_t{0}; i < sources.size(); ++i) {
+			CHECK(levels[i] == reference_levels(g, sources[i]));
+		}
+	}
+}
+
+TEST_CASE("Multi-Source BFS - High Diameter") {
+	// A long ring with a few chords, so most levels are small and expanded top-down.
+	constexpr auto length = 3000;
+	auto g = gdwg::graph<int, int>{};
+	for (auto i = 0; i < length; ++i) {
+		g.insert_node(i);
+	}
+	for (auto i = 0; i < length; ++i) {
+		g.insert_edge(i, (i + 1) % length);
+		if (i % 500 == 0) {
+			g.insert_edge(i, (i + 1250) % length);
+		}
+	}
+	auto sources = std::vector<int>{};
+	for (auto i = 0; i < 70; ++i) {
+		sources.push_back((i * 113) % length);
+	}
+	auto pool = gdwg::worker_pool(GENERATE(std::size_t{1}, std::size_t{3}));
+	auto const levels = gdwg::multi_source_bfs(g, sources, pool);
+	for (auto i = std::size_t{0}; i < sources.size(); ++i) {
+		CHECK(levels[i] == reference_levels(g, sources[i]));
+	}
+}
+
+TEST_CASE("Multi-Source BFS - Callback") {
+	auto g = gdwg::graph<std::string, int>{"a", "b", "c", "d"};
+	g.insert_edge("a", "b");
+	g.insert_edge("b", "c", 2);
+	g.insert_edge("d", "a");
+	auto pool = gdwg::worker_pool(1);
+
+	auto visits = std::vector<std::tuple<std::size_t, std::string, std::uint32_t>>{};
+	gdwg::multi_source_bfs(g, {"a", "d"}, pool, [&](std::size_t i, std::uint32_t node, std::uint32_t level) {
+		visits.emplace_back(i, g.node(node), level);
+	});
+	std::sort(visits.begin(), visits.end());
+	using visit = std::tuple<std::size_t, std::string, std::uint32_t>;
+	CHECK(visits
+	      == std::vector<visit>{
+	          {0, "a", 0},
+	          {0, "b", 1},
+	          {0, "c", 2},
+	          {1, "a", 1},
+	          {1, "b", 2},
+	          {1, "c", 3},
+	          {1, "d", 0},
+	      });
+
+	CHECK_THROWS_MATCHES(gdwg::multi_source_bfs(g, {"a", "z"}),
+	                     std::runtime_error,
+	                     Catch::Matchers::Message("Cannot call gdwg::multi_source_bfs if a source doesn't exist in the "
+	                                              "graph"));
+}